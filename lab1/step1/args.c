@@ -19,11 +19,14 @@ static char args_doc[] = "";
 /* The options we understand. */
 static struct argp_option options[] = {
     {"process", 'p', "NUMBER OF PROCESSES", 0, "Amount of processes (2-15)"},
+    {"transport", 'T', "NAME", 0, "Transport backend (pipe, seqpacket). Default: pipe"},
     {0}
 };
 
 static const char *argp_err_key_nan_fmt = "-%c is not a number. See --help for more information";
 static const char *arg_err_key_required_fmt = "-%c is required. See --help for more information";
+static const char *arg_err_key_transport_fmt
+    = "-%c unknown transport '%s'. See --help for more information";
 static const char *arg_err_key_range_fmt
     = "-%c value is not in correct range. See --help for more information";
 
@@ -66,6 +69,14 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
             break;
         }
 
+        case 'T':
+            arguments->transport = find_transport(arg);
+            if (arguments->transport == NULL) {
+                argp_failure(state, 1, 0, arg_err_key_transport_fmt, key, arg);
+                return ARGP_ERR_UNKNOWN;
+            }
+            break;
+
         case ARGP_KEY_END:
             // check if not enough args
             if (arguments->proc_n == 0) {
@@ -84,6 +95,7 @@ static struct argp argp = {options, parse_opt, args_doc, doc};
 
 void init_defaults(arguments *arguments) {
     arguments->proc_n = 0;
+    arguments->transport = get_default_transport();
 }
 
 void args_parse(int argc, char **argv, arguments *arguments) {
@@ -10,9 +10,12 @@
 #include <argp.h>
 #include <stdint.h>
 
+#include "transport.h"
+
 /* Used by main to communicate with parse_opt. */
 typedef struct {
-    uint8_t proc_n;
+    uint8_t          proc_n;
+    const transport *transport;
 } arguments;
 
 /**
@@ -10,6 +10,7 @@
 #include "executor.h"
 #include "ipc.h"
 #include "logger.h"
+#include "transport.h"
 
 int init_channel(channel *channel) {
     int fd[2];
@@ -128,3 +129,35 @@ channel_h get_channel_write_h(void *self, local_id dst) {
     executor *executor = self;
     return executor->ch_write[dst];
 }
+
+void cleanup_executor_channels(void *self) {
+    executor *executor = self;
+    free(executor->ch_read);
+    free(executor->ch_write);
+}
+
+int write_pipe_channel(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    channel_h channel_h = get_channel_write_h(executor, dst);
+    int       bytes = write(channel_h, msg, sizeof(MessageHeader) + msg->s_header.s_payload_len);
+    return bytes > 0 ? 0 : 1;
+}
+
+int read_pipe_channel(void *self, local_id from, Message *msg) {
+    executor *executor = self;
+    channel_h channel_h = get_channel_read_h(executor, from);
+    if (read(channel_h, &(msg->s_header), sizeof(MessageHeader)) == -1) return -1;
+    if (read(channel_h, msg->s_payload, msg->s_header.s_payload_len) == -1) return 1;
+    return 0;
+}
+
+const transport pipe_transport = {
+    .name = "pipe",
+    .open = open_channels,
+    .set_executor = set_executor_channels,
+    .close_unused = close_unused_channels,
+    .close = close_channels,
+    .cleanup = cleanup_executor_channels,
+    .write = write_pipe_channel,
+    .read = read_pipe_channel,
+};
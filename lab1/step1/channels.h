@@ -128,4 +128,33 @@ int close_channel(channel **channels, local_id from, local_id dst);
  */
 int close_channels(int8_t proc_n, channel **channels);
 
+/**
+ * @brief      Frees the executor pipe handlers arrays.
+ *
+ * @param      executor  The executor
+ */
+void cleanup_executor_channels(void *executor);
+
+/**
+ * @brief      Writes a message to the pipe self -> dst.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int write_pipe_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Reads a message (header, then payload) from the pipe from -> self.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no message or on error
+ */
+int read_pipe_channel(void *executor, local_id from, Message *msg);
+
 #endif  // __ITMO_DISTRIBUTED_CLASS_CHANNELS__H
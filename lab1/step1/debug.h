@@ -24,7 +24,7 @@ static const char* const debug_channel_set_fmt = "[local_id=%d] ch set %c %d ->
 
 static const char* const debug_ipc_receive_fmt = "[local_id=%d] receive [from=%d] rc=%3d\n";
 static const char* const debug_ipc_send_fmt
-    = "[local_id=%1d] [pid=%5d] send %d -> %d [channel_h=%d] [msg_size=%d] bytes=%d\n";
+    = "[local_id=%1d] [pid=%5d] send %d -> %d [transport=%s] [msg_size=%d] rc=%d\n";
 static const char* const debug_ipc_send_multicast_fmt
     = "[local_id=%1d] [pid=%5d] send_multicast.  proc_n: %d \n";
 
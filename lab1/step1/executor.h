@@ -12,14 +12,16 @@
 
 #include "channels.h"
 #include "ipc.h"
+#include "transport.h"
 
 typedef struct {
-    local_id   local_id;    ///< Local process id (usually index of created process)
-    channel_h *ch_read;     ///< Array of reading pipe handlers
-    channel_h *ch_write;    ///< Array of writing pipe handlers
-    int8_t     proc_n;      ///< Number of processes
-    pid_t      parent_pid;  ///< Parend process id
-    pid_t      pid;         ///< Executor process id
+    local_id         local_id;    ///< Local process id (usually index of created process)
+    const transport *transport;   ///< Transport backend used for communication
+    channel_h       *ch_read;     ///< Array of reading pipe handlers
+    channel_h       *ch_write;    ///< Array of writing pipe handlers
+    int8_t           proc_n;      ///< Number of processes
+    pid_t            parent_pid;  ///< Parend process id
+    pid_t            pid;         ///< Executor process id
 } executor;
 
-#endif                      // __ITMO_DISTRIBUTED_CLASS_EXECUTOR__H
+#endif                            // __ITMO_DISTRIBUTED_CLASS_EXECUTOR__H
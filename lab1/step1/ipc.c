@@ -9,6 +9,7 @@ int usleep(__useconds_t useconds);
 #include "debug.h"
 #include "executor.h"
 #include "ipc.h"
+#include "transport.h"
 
 size_t compute_msg_size(const Message *msg) {
     return sizeof(MessageHeader) + msg->s_header.s_payload_len;
@@ -17,18 +18,20 @@ size_t compute_msg_size(const Message *msg) {
 int send(void *self, local_id dst, const Message *msg) {
     executor *executor = self;
     uint16_t  msg_size = compute_msg_size(msg);
-    channel_h channel_h = get_channel_write_h(executor, dst);
-    int       bytes = write(channel_h, msg, msg_size);
+    int       rc = executor->transport->write(executor, dst, msg);
     debug_print(
-        debug_ipc_send_fmt, executor->local_id, executor->pid, executor->local_id, dst, channel_h,
-        msg_size, bytes
+        debug_ipc_send_fmt, executor->local_id, executor->pid, executor->local_id, dst,
+        executor->transport->name, msg_size, rc
     );
-    return bytes > 0 ? 0 : 1;
+    return rc;
 }
 
 int send_multicast(void *self, const Message *msg) {
     executor *executor = self;
     debug_print(debug_ipc_send_multicast_fmt, executor->local_id, executor->pid, executor->proc_n);
+    if (executor->transport->multicast != NULL) {
+        return executor->transport->multicast(executor, msg);
+    }
     int rc = 0;
     for (int dst = 0; dst < executor->proc_n; ++dst) {
         if (executor->local_id == dst) continue;
@@ -40,10 +43,7 @@ int send_multicast(void *self, const Message *msg) {
 
 int receive(void *self, local_id from, Message *msg) {
     executor *executor = self;
-    channel_h channel_h = get_channel_read_h(executor, from);
-    if (read(channel_h, &(msg->s_header), sizeof(MessageHeader)) == -1) return -1;
-    if (read(channel_h, msg->s_payload, msg->s_header.s_payload_len) == -1) return 1;
-    return 0;
+    return executor->transport->read(executor, from, msg);
 }
 
 int receive_any(void *self, Message *msg) {
@@ -11,6 +11,9 @@
 
 static const char *const log_channel_opened_fmt = "Channel opened (%5d -> %5d)\n";
 
+static const char *const log_seqpacket_channel_opened_fmt
+    = "Channel opened (%5d <-> %5d) [seqpacket]\n";
+
 static const char *const log_channel_closed_fmt = "Channel closed (%5d -> %5d)\n";
 
 /**
@@ -12,6 +12,7 @@
 #include "ipc.h"
 #include "logger.h"
 #include "pa1.h"
+#include "transport.h"
 #include "worker.h"
 
 int is_parent(pid_t parent_pid) {
@@ -19,7 +20,8 @@ int is_parent(pid_t parent_pid) {
 }
 
 void create_child_process(
-    int proc_n, pid_t parent_pid, int local_id, executor *executor, channel **channels
+    int proc_n, pid_t parent_pid, int local_id, executor *executor, channel **channels,
+    const transport *transport
 ) {
     // fork only main parent process
     if (!is_parent(parent_pid)) return;
@@ -30,34 +32,38 @@ void create_child_process(
         pid_t p_pid = getppid();
 
         executor->local_id = local_id;
+        executor->transport = transport;
         executor->proc_n = proc_n;
         executor->parent_pid = p_pid;
         executor->pid = pid;
 
-        set_executor_channels(proc_n, executor, channels);
-        close_unused_channels(proc_n, local_id, channels);
+        transport->set_executor(proc_n, executor, channels);
+        transport->close_unused(proc_n, local_id, channels);
         debug_print(debug_forked_fmt, pid, p_pid, local_id);
     }
 }
 
-void create_processes(int proc_n, pid_t parent_pid, executor *executor, channel **channels) {
+void create_processes(
+    int proc_n, pid_t parent_pid, executor *executor, channel **channels, const transport *transport
+) {
     debug_print(debug_forked_fmt, getpid(), getppid(), PARENT_ID);
     debug_print(debug_start_fork_fmt, getpid());
 
     executor->local_id = PARENT_ID;
+    executor->transport = transport;
     executor->proc_n = proc_n;
     executor->parent_pid = 0;
     executor->pid = getpid();
 
-    set_executor_channels(proc_n, executor, channels);
+    transport->set_executor(proc_n, executor, channels);
 
     for (int local_id = 1; local_id < proc_n; ++local_id) {
-        create_child_process(proc_n, parent_pid, local_id, executor, channels);
+        create_child_process(proc_n, parent_pid, local_id, executor, channels, transport);
     }
     debug_print(debug_proc_created_fmt, getpid());
 }
 
-void init(int proc_n, channel ***channels) {
+void init(int proc_n, const transport *transport, channel ***channels) {
     *channels = malloc(proc_n * sizeof(channel *));
     for (int i = 0; i < proc_n; ++i) { (*channels)[i] = malloc(proc_n * sizeof(channel)); }
     debug_print(debug_malloc_ch_fin_fmt, (void *)*channels);
@@ -65,7 +71,7 @@ void init(int proc_n, channel ***channels) {
         perror("Failed to create channels");
         exit(1);
     }
-    if (open_channels(proc_n, *channels) != 0) {
+    if (transport->open(proc_n, *channels) != 0) {
         perror("Failed to open channels");
         exit(1);
     };
@@ -73,14 +79,13 @@ void init(int proc_n, channel ***channels) {
     open_events_log_f();
 }
 
-void cleanup(int proc_n, channel **channels, executor *executor) {
+void cleanup(int proc_n, const transport *transport, channel **channels, executor *executor) {
     if (executor->local_id == PARENT_ID) {
         // wait all child processes
         while (wait(NULL) > 0) {}
-        close_channels(proc_n, channels);
+        transport->close(proc_n, channels);
     }
-    free(executor->ch_read);
-    free(executor->ch_write);
+    transport->cleanup(executor);
     for (int i = 0; i < proc_n; ++i) free(channels[i]);
     free(channels);
     close_pipes_log_f();
@@ -96,16 +101,20 @@ int main(int argc, char **argv) {
     debug_print(debug_main_args_parsed_fmt, argc, arguments.proc_n);
 
     channel **channels;
-    init(arguments.proc_n, &channels);
+    init(arguments.proc_n, arguments.transport, &channels);
 
     executor executor;
     pid_t    parent_pid = getpid();
-    create_processes(arguments.proc_n, parent_pid, &executor, channels);
-    if (is_parent(parent_pid)) close_unused_channels(arguments.proc_n, PARENT_ID, channels);
+    create_processes(arguments.proc_n, parent_pid, &executor, channels, arguments.transport);
+    if (is_parent(parent_pid)) {
+        arguments.transport->close_unused(arguments.proc_n, PARENT_ID, channels);
+    }
 
     debug_print(debug_executor_info_fmt, executor.pid, executor.parent_pid, executor.local_id);
     run_worker(&executor);
 
-    if (is_parent(parent_pid)) { cleanup(arguments.proc_n, channels, &executor); }
+    if (is_parent(parent_pid)) {
+        cleanup(arguments.proc_n, arguments.transport, channels, &executor);
+    }
     return 0;
 }
@@ -0,0 +1,75 @@
+#include "seqpacket.h"
+
+#include <stdlib.h>
+#include <sys/types.h>
+
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "packet.h"
+#include "transport.h"
+
+int open_seqpacket_channels(int8_t proc_n, channel **channels) {
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = 0; dst < proc_n; ++dst) {
+            channels[from][dst].read_h = -1;
+            channels[from][dst].write_h = -1;
+        }
+    }
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = from + 1; dst < proc_n; ++dst) {
+            int fd[2];
+            if (open_packet_pair(fd) != 0) return 1;
+            channels[from][dst].read_h = fd[0];
+            channels[dst][from].read_h = fd[1];
+            debug_print(debug_channel_open_fmt, from, dst, 0, fd[0], fd[1]);
+            log_pipes_msg(log_seqpacket_channel_opened_fmt, from, dst);
+        }
+    }
+    return 0;
+}
+
+int close_unused_seqpacket_channels(int8_t proc_n, local_id local_id, channel **channels) {
+    // process uses only own sockets of pairs with other processes
+    for (int from = 0; from < proc_n; ++from) {
+        if (from == local_id) continue;
+        for (int dst = 0; dst < proc_n; ++dst) close_channel(channels, from, dst);
+    }
+    return 0;
+}
+
+void set_executor_seqpacket_channels(int8_t proc_n, void *self, channel **channels) {
+    executor *executor = self;
+    local_id  local_id = executor->local_id;
+    executor->ch_read = malloc(proc_n * sizeof(channel_h));
+    executor->ch_write = malloc(proc_n * sizeof(channel_h));
+    for (int other_id = 0; other_id < proc_n; ++other_id) {
+        executor->ch_read[other_id] = channels[local_id][other_id].read_h;
+        executor->ch_write[other_id] = channels[local_id][other_id].read_h;
+    }
+}
+
+int write_seqpacket_channel(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    size_t    size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    return send_packet(get_channel_write_h(executor, dst), msg, size) == (ssize_t)size ? 0 : 1;
+}
+
+int read_seqpacket_channel(void *self, local_id from, Message *msg) {
+    executor *executor = self;
+    channel_h channel_h = get_channel_read_h(executor, from);
+    if (channel_h == -1) return -1;
+    return recv_packet(channel_h, msg, sizeof(Message)) > 0 ? 0 : -1;
+}
+
+const transport seqpacket_transport = {
+    .name = "seqpacket",
+    .open = open_seqpacket_channels,
+    .set_executor = set_executor_seqpacket_channels,
+    .close_unused = close_unused_seqpacket_channels,
+    .close = close_channels,
+    .cleanup = cleanup_executor_channels,
+    .write = write_seqpacket_channel,
+    .read = read_seqpacket_channel,
+};
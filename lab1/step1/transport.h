@@ -0,0 +1,84 @@
+/**
+ * @file     transport.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Transport backend interface used by send and receive (backend is selected at startup)
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_TRANSPORT__H
+#define __ITMO_DISTRIBUTED_CLASS_TRANSPORT__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+/**
+ * Transport backend operations. Mesh operations are called with the channels matrix, data
+ * operations are called with the executor pointer.
+ */
+typedef struct {
+    const char *name;  ///< Backend name used in command line
+
+    /**
+     * Open communication mesh for all processes (called in parent before fork)
+     */
+    int (*open)(int8_t proc_n, channel **channels);
+
+    /**
+     * Set executor communication handlers (called in each process after fork)
+     */
+    void (*set_executor)(int8_t proc_n, void *executor, channel **channels);
+
+    /**
+     * Close handlers that are not used by process with local_id (called after set_executor)
+     */
+    int (*close_unused)(int8_t proc_n, local_id local_id, channel **channels);
+
+    /**
+     * Close communication mesh (called after worker is finished)
+     */
+    int (*close)(int8_t proc_n, channel **channels);
+
+    /**
+     * Release executor communication handlers (called on executor cleanup)
+     */
+    void (*cleanup)(void *executor);
+
+    /**
+     * Write message to the channel self -> dst. 0 on success, any non-zero value on error
+     */
+    int (*write)(void *executor, local_id dst, const Message *msg);
+
+    /**
+     * Write message to all other processes at once (nullable, write is called for every process
+     * otherwise). 0 on success, any non-zero value on error
+     */
+    int (*multicast)(void *executor, const Message *msg);
+
+    /**
+     * Read message from the channel from -> self without waiting. 0 on success, any non-zero
+     * value if there is no message or on error
+     */
+    int (*read)(void *executor, local_id from, Message *msg);
+} transport;
+
+extern const transport pipe_transport;       ///< Pipes matrix backend (channels.c)
+extern const transport seqpacket_transport;  ///< Unix socket pair per processes pair (seqpacket.c)
+
+/**
+ * @brief      Find transport backend by name.
+ *
+ * @param[in]  name  The backend name
+ *
+ * @return     The transport backend pointer, NULL if there is no backend with such name
+ */
+const transport *find_transport(const char *name);
+
+/**
+ * @brief      Gets the default transport backend (pipes).
+ *
+ * @return     The default transport backend pointer
+ */
+const transport *get_default_transport();
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_TRANSPORT__H
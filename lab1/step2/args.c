@@ -6,6 +6,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "lane.h"
+
 #define MAX_BALANCE 65535
 
 const char *argp_program_version = "pa1";
@@ -25,11 +27,19 @@ static struct argp_option options[] = {
     {"debug-ipc", 'i', 0, OPTION_ARG_OPTIONAL, "Enable debug messages for IPC"},
     {"debug-time", 't', 0, OPTION_ARG_OPTIONAL, "Enable debug messages for TIME"},
     {"debug-worker", 'w', 0, OPTION_ARG_OPTIONAL, "Enable debug messages for WORKER"},
+    {"transport", 'T', "NAME", 0, "Transport backend (pipe, seqpacket). Default: pipe"},
+    {"bulk", 'B', "TYPES", 0,
+     "Message types received after control messages, comma separated. "
+     "Default: TRANSFER,BALANCE_HISTORY"},
     {0}
 };
 
 static const char *argp_err_key_nan_fmt = "-%c is not a number. See --help for more information";
 static const char *arg_err_key_required_fmt = "-%c is required. See --help for more information";
+static const char *arg_err_key_transport_fmt
+    = "-%c unknown transport '%s'. See --help for more information";
+static const char *arg_err_key_msg_type_fmt
+    = "-%c unknown message type in '%s'. See --help for more information";
 static const char *arg_err_key_range_fmt
     = "-%c value is not in correct range. See --help for more information";
 static const char *arg_err_too_many_args_fmt
@@ -97,6 +107,21 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
             arguments->debug_worker = 1;
             break;
 
+        case 'T':
+            arguments->transport = find_transport(arg);
+            if (arguments->transport == NULL) {
+                argp_failure(state, 1, 0, arg_err_key_transport_fmt, key, arg);
+                return ARGP_ERR_UNKNOWN;
+            }
+            break;
+
+        case 'B':
+            if (set_bulk_msg_types(arg) != 0) {
+                argp_failure(state, 1, 0, arg_err_key_msg_type_fmt, key, arg);
+                return ARGP_ERR_UNKNOWN;
+            }
+            break;
+
         case ARGP_KEY_ARG: {
             if (arguments->proc_n && state->arg_num >= arguments->proc_n) {
                 argp_failure(state, 1, 0, "%s", arg_err_too_many_args_fmt);
@@ -148,6 +173,7 @@ void init_defaults(arguments *arguments) {
     arguments->debug_ipc = 0;
     arguments->debug_time = 0;
     arguments->debug_worker = 0;
+    arguments->transport = get_default_transport();
 }
 
 void args_parse(int argc, char **argv, arguments *arguments) {
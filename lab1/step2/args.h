@@ -12,15 +12,17 @@
 
 #include "banking.h"
 #include "ipc.h"
+#include "transport.h"
 
 /* Used by main to communicate with parse_opt. */
 typedef struct {
-    uint8_t   proc_n;
-    uint8_t   debug;
-    uint8_t   debug_ipc;
-    uint8_t   debug_time;
-    uint8_t   debug_worker;
-    balance_t start_balance[MAX_PROCESS_ID + 1];
+    uint8_t          proc_n;
+    uint8_t          debug;
+    uint8_t          debug_ipc;
+    uint8_t          debug_time;
+    uint8_t          debug_worker;
+    const transport *transport;
+    balance_t        start_balance[MAX_PROCESS_ID + 1];
 } arguments;
 
 /**
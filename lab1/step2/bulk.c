@@ -0,0 +1,64 @@
+// MAP_ANONYMOUS is not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "bulk.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "ipc.h"
+
+size_t get_bulk_buf_size() {
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    return (MAX_MESSAGE_LEN + page_size - 1) / page_size * page_size;
+}
+
+/**
+ * @brief      Maps n page-aligned buffers at once.
+ *
+ * @return     The buffers or NULL on error
+ */
+char *map_bulk_bufs(uint16_t n) {
+    char *bufs = mmap(
+        NULL, n * get_bulk_buf_size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    return bufs == MAP_FAILED ? NULL : bufs;
+}
+
+void init_bulk_buffers(BulkBuffers *bulk) {
+    memset(bulk, 0, sizeof(BulkBuffers));
+}
+
+void destroy_bulk_buffers(BulkBuffers *bulk) {
+    // pipe keeps its own references to spliced pages, so they stay valid for the reader
+    if (bulk->copied != NULL) munmap(bulk->copied, get_bulk_buf_size());
+    for (int dst = 0; dst <= MAX_PROCESS_ID; ++dst) {
+        BulkRing *ring = &bulk->spliced[dst];
+        if (ring->bufs != NULL) munmap(ring->bufs, ring->n * get_bulk_buf_size());
+    }
+    init_bulk_buffers(bulk);
+}
+
+Message *get_copied_bulk_buf(BulkBuffers *bulk) {
+    if (bulk->copied == NULL) bulk->copied = map_bulk_bufs(1);
+    return (Message *)bulk->copied;
+}
+
+Message *get_spliced_bulk_buf(BulkBuffers *bulk, local_id dst, uint16_t depth) {
+    BulkRing *ring = &bulk->spliced[dst];
+    if (ring->bufs == NULL) {
+        ring->bufs = map_bulk_bufs(depth + 1);
+        if (ring->bufs == NULL) return NULL;
+        ring->n = depth + 1;
+        ring->next = 0;
+    }
+    return (Message *)(ring->bufs + ring->next * get_bulk_buf_size());
+}
+
+void advance_spliced_bulk_buf(BulkBuffers *bulk, local_id dst) {
+    BulkRing *ring = &bulk->spliced[dst];
+    if (ring->n > 0) ring->next = (ring->next + 1) % ring->n;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file     bulk.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Page-aligned buffers of bulk messages allocated once per executor and reused
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_BULK__H
+#define __ITMO_DISTRIBUTED_CLASS_BULK__H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ipc.h"
+
+/**
+ * Buffers of messages spliced to one channel. Channel refers to the pages of spliced message until
+ * the reader reads it and holds at most depth spliced messages, so with depth + 1 buffers a buffer
+ * is reused only after depth later messages were spliced, i.e. when channel has released it.
+ */
+typedef struct {
+    char    *bufs;  ///< Buffers of one bulk message size each (NULL until the first message)
+    uint16_t n;     ///< Number of buffers
+    uint16_t next;  ///< Index of the buffer of the next spliced message
+} BulkRing;
+
+typedef struct {
+    char    *copied;                       ///< Buffer of copied messages (free right after send)
+    BulkRing spliced[MAX_PROCESS_ID + 1];  ///< Buffers of spliced messages, indexed by dst
+} BulkBuffers;
+
+/**
+ * @brief      Gets size of page-aligned buffer holding any message.
+ */
+size_t get_bulk_buf_size();
+
+/**
+ * @brief      Initializes bulk buffers (buffers are allocated on first use).
+ */
+void init_bulk_buffers(BulkBuffers *bulk);
+
+/**
+ * @brief      Releases bulk buffers. Channels keep spliced pages they still refer to.
+ */
+void destroy_bulk_buffers(BulkBuffers *bulk);
+
+/**
+ * @brief      Gets the buffer of a message copied to transport.
+ *
+ * @return     The buffer or NULL on error
+ */
+Message *get_copied_bulk_buf(BulkBuffers *bulk);
+
+/**
+ * @brief      Gets the buffer of the next message spliced to dst.
+ *
+ * @param      bulk   The bulk buffers
+ * @param[in]  dst    The destination
+ * @param[in]  depth  The max number of spliced messages held by channel self -> dst
+ *
+ * @return     The buffer or NULL on error
+ */
+Message *get_spliced_bulk_buf(BulkBuffers *bulk, local_id dst, uint16_t depth);
+
+/**
+ * @brief      Moves to the next buffer of dst after a message was spliced to dst.
+ */
+void advance_spliced_bulk_buf(BulkBuffers *bulk, local_id dst);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_BULK__H
@@ -1,15 +1,22 @@
+// vmsplice is not a part of c99
+#define _GNU_SOURCE
+
 #include "channels.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "debug.h"
 #include "executor.h"
 #include "ipc.h"
 #include "logger.h"
+#include "transport.h"
 
 int init_channel(channel *channel) {
     int fd[2];
@@ -140,3 +147,123 @@ channel_h get_channel_write_h(void *self, local_id dst) {
     executor *executor = self;
     return executor->ch_write[dst];
 }
+
+int wait_channel_h(channel_h channel_h, short events) {
+    struct pollfd pfd = {.fd = channel_h, .events = events};
+    int           rc = 0;
+    while ((rc = poll(&pfd, 1, -1)) < 0 && errno == EINTR) {}
+    if (rc < 0) return 1;
+    return pfd.revents & events ? 0 : 1;
+}
+
+int wait_channel_writable(void *self, local_id dst) {
+    return wait_channel_h(get_channel_write_h(self, dst), POLLOUT);
+}
+
+int wait_channels_readable(void *self, const uint8_t *skipped) {
+    executor     *executor = self;
+    struct pollfd pfds[MAX_PROCESS_ID + 1];
+    nfds_t        n = 0;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (from == executor->local_id || skipped[from]) continue;
+        channel_h channel_h = get_channel_read_h(executor, from);
+        if (channel_h < 0) continue;
+        pfds[n++] = (struct pollfd){.fd = channel_h, .events = POLLIN};
+    }
+    if (n == 0) return 1;
+    int rc = 0;
+    while ((rc = poll(pfds, n, -1)) < 0 && errno == EINTR) {}
+    if (rc < 0) return 1;
+    for (nfds_t i = 0; i < n; ++i) {
+        if (pfds[i].revents & POLLIN) return 0;
+    }
+    // all polled channels are closed by other side
+    return 1;
+}
+
+void cleanup_executor_channels(void *self) {
+    executor *executor = self;
+    free(executor->ch_read);
+    free(executor->ch_write);
+}
+
+int write_pipe_channel(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    channel_h channel_h = get_channel_write_h(executor, dst);
+    int       bytes = write(channel_h, msg, sizeof(MessageHeader) + msg->s_header.s_payload_len);
+    return bytes > 0 ? 0 : 1;
+}
+
+int splice_pipe_channel(void *self, local_id dst, const Message *msg) {
+    executor    *executor = self;
+    channel_h    channel_h = get_channel_write_h(executor, dst);
+    struct iovec iov = {
+        .iov_base = (void *)msg, .iov_len = sizeof(MessageHeader) + msg->s_header.s_payload_len
+    };
+    while (iov.iov_len > 0) {
+        // without SPLICE_F_GIFT pages stay owned by sender and pipe refers to them, so the buffer
+        // must not be reused until the reader drains it (see BulkRing)
+        ssize_t bytes = vmsplice(channel_h, &iov, 1, SPLICE_F_NONBLOCK);
+        if (bytes < 0 && errno == EAGAIN && iov.iov_base != msg) {
+            // message is already started, reader waits for the rest of it
+            if (wait_channel_h(channel_h, POLLOUT) != 0) return 1;
+            continue;
+        }
+        if (bytes <= 0) return 1;
+        iov.iov_base = (char *)iov.iov_base + bytes;
+        iov.iov_len -= bytes;
+    }
+    return 0;
+}
+
+uint16_t get_pipe_splice_depth(void *self, local_id dst) {
+    executor *executor = self;
+    int       pipe_size = fcntl(get_channel_write_h(executor, dst), F_GETPIPE_SZ);
+    size_t    page_size = sysconf(_SC_PAGESIZE);
+    // every spliced page takes its own pipe buffer slot
+    return pipe_size > 0 ? pipe_size / page_size : PIPE_DEFAULT_SLOTS;
+}
+
+/**
+ * @brief      Reads exactly size bytes of started message.
+ *
+ * @return     0 on success, any non-zero value on error or end of pipe.
+ */
+int read_pipe_rest(channel_h channel_h, char *buf, size_t size) {
+    while (size > 0) {
+        ssize_t bytes = read(channel_h, buf, size);
+        if (bytes < 0 && errno == EAGAIN) {
+            // writer has started the message, so the rest of it is coming
+            if (wait_channel_h(channel_h, POLLIN) != 0) return 1;
+            continue;
+        }
+        if (bytes <= 0) return 1;
+        buf += bytes;
+        size -= bytes;
+    }
+    return 0;
+}
+
+int read_pipe_channel(void *self, local_id from, Message *msg) {
+    executor *executor = self;
+    channel_h channel_h = get_channel_read_h(executor, from);
+    if (channel_h == -1) return -1;
+    if (read(channel_h, &(msg->s_header), sizeof(MessageHeader)) <= 0) return -1;
+    if (msg->s_header.s_payload_len > 0
+        && read_pipe_rest(channel_h, msg->s_payload, msg->s_header.s_payload_len) != 0)
+        return 1;
+    return 0;
+}
+
+const transport pipe_transport = {
+    .name = "pipe",
+    .open = open_channels,
+    .set_executor = set_executor_channels,
+    .close_unused = close_unused_channels,
+    .close = close_channels,
+    .cleanup = cleanup_executor_channels,
+    .write = write_pipe_channel,
+    .splice = splice_pipe_channel,
+    .get_splice_depth = get_pipe_splice_depth,
+    .read = read_pipe_channel,
+};
@@ -22,7 +22,9 @@ typedef struct {
     channel_h write_h;         ///< write handler for pipe
 } channel;
 
-#define SLEEP_RECEIVE_USEC 10  // 10 usec between receive any msg
+#define SLEEP_RECEIVE_USEC 10    // 10 usec between receive any msg
+#define SPLICE_MIN_PAYLOAD 1024  // payloads of this size and more are spliced to pipe by pages
+#define PIPE_DEFAULT_SLOTS 16    // number of pipe buffer slots if pipe size is unknown
 
 // int nanosleep(const struct timespec *req, struct timespec * rem);
 
@@ -108,6 +110,38 @@ channel_h get_channel_read_h(void *self, local_id from);
  */
 channel_h get_channel_write_h(void *self, local_id dst);
 
+/**
+ * @brief      Wait until a channel handler is ready for events without timeout (e.g. the pipe is
+ * not full anymore or has data to read).
+ *
+ * @param[in]  channel_h  The channel handler
+ * @param[in]  events     The poll events (POLLIN or POLLOUT)
+ *
+ * @return     0 if handler is ready, any non-zero value on error (e.g. other side is closed)
+ */
+int wait_channel_h(channel_h channel_h, short events);
+
+/**
+ * @brief      Wait until the channel self -> dst can be written without timeout.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ *
+ * @return     0 if channel is writable, any non-zero value on error
+ */
+int wait_channel_writable(void *executor, local_id dst);
+
+/**
+ * @brief      Wait until any channel from -> self can be read without timeout.
+ *
+ * @param      executor  The executor
+ * @param[in]  skipped   The flags of channels which are not waited for, indexed by local id
+ *
+ * @return     0 if a channel is readable, any non-zero value on error (e.g. all other sides are
+ * closed)
+ */
+int wait_channels_readable(void *executor, const uint8_t *skipped);
+
 /**
  * @brief      Closes a channel from -> dst.
  *
@@ -130,4 +164,59 @@ int close_channel(channel **channels, local_id from, local_id dst);
  */
 int close_channels(int8_t proc_n, channel **channels);
 
+/**
+ * @brief      Frees the executor pipe handlers arrays.
+ *
+ * @param      executor  The executor
+ */
+void cleanup_executor_channels(void *executor);
+
+/**
+ * @brief      Writes a message to the pipe self -> dst.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int write_pipe_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Moves pages of a message allocated with new_bulk_msg to the pipe self -> dst without
+ * copying them (vmsplice). Pages are not gifted, so pipe refers to the sender pages until they are
+ * read: message can be unmapped after call, but its buffer must not be changed or reused until
+ * the pipe releases it. Waits for the reader while the pipe is full once the message is started.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int splice_pipe_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Gets max number of spliced messages held by the pipe self -> dst (number of pipe
+ * buffer slots, each spliced message takes one at least).
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ *
+ * @return     The number of messages
+ */
+uint16_t get_pipe_splice_depth(void *executor, local_id dst);
+
+/**
+ * @brief      Reads a message (header, then payload) from the pipe from -> self. Payload spliced
+ * by pages can come in several parts, so it is read until the end once header is read.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no message or on error
+ */
+int read_pipe_channel(void *executor, local_id from, Message *msg);
+
 #endif  // __ITMO_DISTRIBUTED_CLASS_CHANNELS__H
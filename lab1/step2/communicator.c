@@ -1,5 +1,6 @@
 #include "communicator.h"
 
+#include <errno.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -7,12 +8,15 @@
 #include <unistd.h>
 
 #include "banking.h"
+#include "bulk.h"
 #include "channels.h"
 #include "debug.h"
 #include "ipc.h"
 #include "ipc_util.h"
+#include "lane.h"
 #include "logger.h"
 #include "pa2345.h"
+#include "stream.h"
 #include "time.h"
 
 int usleep(__useconds_t useconds);
@@ -40,12 +44,49 @@ int construct_msg(Message *msg, MessageType type, uint16_t payload_len) {
     return 0;
 }
 
+Message *new_bulk_msg(executor *self, local_id dst, MessageType type, uint16_t payload_len) {
+    if (payload_len > MAX_PAYLOAD_LEN) return NULL;
+    Message *msg = NULL;
+    if (is_bulk_spliced(self, payload_len)) {
+        uint16_t depth = self->transport->get_splice_depth(self, dst);
+        msg = get_spliced_bulk_buf(&self->bulk, dst, depth);
+    } else {
+        msg = get_copied_bulk_buf(&self->bulk);
+    }
+    if (msg == NULL) return NULL;
+    construct_msg(msg, type, payload_len);
+    return msg;
+}
+
 int tick_send(executor *self, local_id dst, Message *msg) {
     next_tick(TIME_UNSET);
     msg->s_header.s_local_time = get_lamport_time();
     return send(self, dst, msg);
 }
 
+int tick_send_stream(
+    executor *self, local_id dst, MessageType type, const void *data, uint32_t len
+) {
+    next_tick(TIME_UNSET);
+    timestamp_t time = get_lamport_time();
+    uint32_t    offset = 0;
+    do {
+        uint16_t chunk_len = get_chunk_len(len, offset);
+        Message *msg = new_bulk_msg(self, dst, STREAM_CHUNK, sizeof(ChunkHeader) + chunk_len);
+        if (msg == NULL) return -1;
+        write_chunk(msg, type, data, len, offset);
+        msg->s_header.s_local_time = time;
+        int rc = 0;
+        // channel is full until receiver reads previous chunks
+        while ((rc = send_bulk(self, dst, msg)) != 0 && errno == EAGAIN) {
+            if (wait_channel_writable(self, dst) != 0) break;
+        }
+        if (rc != 0) return rc;
+        offset += chunk_len;
+    } while (offset < len);
+    return 0;
+}
+
 int tick_send_multicast(executor *self, Message *msg) {
     next_tick(TIME_UNSET);
     msg->s_header.s_local_time = get_lamport_time();
@@ -112,6 +153,52 @@ int wait_receive_all_child_msg_by_type(executor *self, MessageType type, on_mess
     return 0;
 }
 
+int wait_receive_all_child_stream_by_type(executor *self, MessageType type, on_stream_t on_stream) {
+    uint8_t   received[MAX_PROCESS_ID + 1] = {0};
+    LaneState deferred;
+    Message   msg;
+    local_id  from = 0;
+    int8_t    idle = 0;  // channels tried since the last received message
+    int       rc = 0;
+    init_lanes(&deferred);
+    while (rc == 0 && !is_received_all_child(self, received)) {
+        if (idle >= self->proc_n) {
+            // whole round is empty, so sleep until a channel has data instead of polling
+            if (wait_channels_readable(self, received) != 0) rc = -1;
+            idle = 0;
+            continue;
+        }
+        from = (from + 1) % self->proc_n;
+        ++idle;
+        if (self->local_id == from) continue;
+        if (is_received_msg_from(self, received, from)) continue;
+        if (receive(self, from, &msg) != 0) continue;
+        idle = 0;
+        if (get_stream_msg_type(&msg) != type) {
+            // message (or chunk of other stream) is kept until the awaited streams are received
+            rc = push_bulk_msg(&deferred, from, &msg);
+            continue;
+        }
+        if (msg.s_header.s_type != STREAM_CHUNK) {
+            // short message is sent without stream
+            if (on_stream != NULL) on_stream(self, msg.s_payload, msg.s_header.s_payload_len, from);
+            mark_received(received, from);
+            continue;
+        }
+        if (on_stream_chunk(&self->streams, from, &msg) != 1) continue;
+        uint32_t    len = 0;
+        const void *data = get_stream_data(&self->streams, from, &len);
+        if (on_stream != NULL) on_stream(self, data, len, from);
+        finish_stream(&self->streams, from);
+        mark_received(received, from);
+    }
+    for (local_id other = 0; other < self->proc_n; ++other) {
+        move_bulk_lane_front(&self->lanes, &deferred, other);
+    }
+    destroy_lanes(&deferred);
+    return rc;
+}
+
 int wait_receive_msg_by_type(executor *self, MessageType type, local_id from) {
     Message  msg;
     uint16_t received = 0;
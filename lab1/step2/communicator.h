@@ -113,6 +113,31 @@ typedef void (*on_message_t)(executor *, Message *, local_id);
 
 int wait_receive_all_child_msg_by_type(executor *self, MessageType type, on_message_t on_message);
 
+/**
+ * Callback type for streamed message handling
+ *
+ * @param       self        The executor process info pointer
+ * @param       data        The message bytes (valid until callback returns)
+ * @param       len         The number of message bytes
+ * @param       local_id    Local process id mesage received from
+ */
+typedef void (*on_stream_t)(executor *, const void *, uint32_t, local_id);
+
+/**
+ * @brief      Wait for all streamed messages with specified type received from children. Chunks
+ * are received into buffers set with set_stream_target (if they are large enough). Messages of
+ * other types are put back into bulk lanes of their channels to be received later. Sleeps in poll
+ * while no channel has data.
+ *
+ * @param      self       The executor process
+ * @param[in]  type       The message type
+ * @param[in]  on_stream  On message callback (can be NULL for no callback)
+ *
+ * @return     0 on success, any non-zero value on error (e.g. message of other type can not be
+ * allocated or all children closed their channels)
+ */
+int wait_receive_all_child_stream_by_type(executor *self, MessageType type, on_stream_t on_stream);
+
 /**
  * @brief      Wait for a message with specified type received from specified children
  *
@@ -135,6 +160,36 @@ int wait_receive_msg_by_type(executor *self, MessageType type, local_id from);
  */
 int tick_send(executor *self, local_id dst, Message *msg);
 
+/**
+ * @brief      Gets a message in page-aligned buffer of executor, so large payload can be moved to
+ * transport without copying (see send_bulk). Buffers are reused: message stays valid until the
+ * next call, it is not freed by caller.
+ *
+ * @param      self         The object
+ * @param[in]  dst          The destination
+ * @param[in]  type         The message type
+ * @param[in]  payload_len  The payload length
+ *
+ * @return     The message with constructed header or NULL on error
+ */
+Message *new_bulk_msg(executor *self, local_id dst, MessageType type, uint16_t payload_len);
+
+/**
+ * @brief      Update time and send a message of any length as a stream of chunks. Chunks go in
+ * the lane of message type, so control messages are not blocked behind them
+ *
+ * @param      self  The object
+ * @param[in]  dst   The destination
+ * @param[in]  type  The message type
+ * @param[in]  data  The message bytes
+ * @param[in]  len   The number of message bytes
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int tick_send_stream(
+    executor *self, local_id dst, MessageType type, const void *data, uint32_t len
+);
+
 /**
  * @brief      Update time and send a message musticast
  *
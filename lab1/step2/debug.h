@@ -78,7 +78,7 @@ static const char* const debug_channel_set_fmt = "[local_id=%2d] ch set %c %d ->
 static const char* const debug_ipc_receive_fmt
     = "%2d: [local_id=%2d] recv %2d <- %2d <type=%15s> [msg_time=%2d] [prev_time=%2d] [bytes=%d]\n";
 static const char* const debug_ipc_send_fmt
-    = "%2d: [local_id=%2d] send %2d -> %2d <type=%15s> [msg_time=%2d] [bytes=%d] [channel_h=%d]\n";
+    = "%2d: [local_id=%2d] send %2d -> %2d <type=%15s> [msg_time=%2d] [bytes=%d] [transport=%s]\n";
 static const char* const debug_ipc_send_multicast_fmt
     = "%2d: [local_id=%2d] send %2d ->  * <type=%15s> [msg_time=%2d]\n";
 static const char* const debug_ipc_wait_msg_fmt
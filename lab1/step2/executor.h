@@ -11,8 +11,12 @@
 #include <unistd.h>
 
 #include "banking.h"
+#include "bulk.h"
 #include "channels.h"
 #include "ipc.h"
+#include "lane.h"
+#include "stream.h"
+#include "transport.h"
 
 typedef struct {
     balance_t       balance;  ///< Bank account balance state
@@ -21,14 +25,18 @@ typedef struct {
 } BankAccount;
 
 typedef struct {
-    local_id    local_id;      ///< Local process id (usually index of created process)
-    channel_h  *ch_read;       ///< Array of reading pipe handlers
-    channel_h  *ch_write;      ///< Array of writing pipe handlers
-    int8_t      proc_n;        ///< Number of processes
-    int8_t      is_running;    ///< Running state
-    pid_t       parent_pid;    ///< Parend process id
-    pid_t       pid;           ///< Executor process id
-    BankAccount bank_account;  ///< Bank account connected with executor
+    local_id         local_id;      ///< Local process id (usually index of created process)
+    const transport *transport;     ///< Transport backend used for communication
+    channel_h       *ch_read;       ///< Array of reading pipe handlers
+    channel_h       *ch_write;      ///< Array of writing pipe handlers
+    int8_t           proc_n;        ///< Number of processes
+    int8_t           is_running;    ///< Running state
+    pid_t            parent_pid;    ///< Parend process id
+    pid_t            pid;           ///< Executor process id
+    BankAccount      bank_account;  ///< Bank account connected with executor
+    LaneState        lanes;         ///< Bulk messages waiting behind control messages
+    StreamState      streams;       ///< Streamed messages being received
+    BulkBuffers      bulk;          ///< Reused buffers of bulk messages being sent
 } executor;
 
-#endif                         // __ITMO_DISTRIBUTED_CLASS_EXECUTOR__H
+#endif                              // __ITMO_DISTRIBUTED_CLASS_EXECUTOR__H
@@ -4,11 +4,15 @@
 #include <unistd.h>
 
 #include "banking.h"
+#include "bulk.h"
 #include "channels.h"
 #include "debug.h"
 #include "executor.h"
 #include "ipc_util.h"
+#include "lane.h"
+#include "stream.h"
 #include "time.h"
+#include "transport.h"
 
 size_t compute_msg_size(const Message *msg) {
     return sizeof(MessageHeader) + msg->s_header.s_payload_len;
@@ -39,22 +43,42 @@ char *get_msg_type_text(const MessageType type) {
     }
 }
 
-int send(void *self, local_id dst, const Message *msg) {
-    executor *executor = self;
-    uint16_t  msg_size = compute_msg_size(msg);
-    channel_h channel_h = get_channel_write_h(executor, dst);
-    int       bytes = write(channel_h, msg, msg_size);
+/**
+ * @brief      Print sent message.
+ */
+void on_sent(executor *executor, local_id dst, const Message *msg, int rc) {
     debug_ipc_print(
         debug_ipc_send_fmt, get_lamport_time(), executor->local_id, executor->local_id, dst,
-        get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time, bytes, channel_h
+        get_msg_type_text(get_stream_msg_type(msg)), msg->s_header.s_local_time,
+        rc == 0 ? (int)compute_msg_size(msg) : -1, executor->transport->name
     );
-    int rc = bytes > 0 ? 0 : 1;
     if (rc != 0) {
         debug_ipc_print(
             debug_ipc_send_failed_fmt, get_lamport_time(), executor->local_id, executor->local_id,
-            dst, get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time
+            dst, get_msg_type_text(get_stream_msg_type(msg)), msg->s_header.s_local_time
         );
     }
+}
+
+int send(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    int       rc = executor->transport->write(executor, dst, msg);
+    on_sent(executor, dst, msg, rc);
+    return rc;
+}
+
+int is_bulk_spliced(void *self, uint16_t payload_len) {
+    executor *executor = self;
+    return executor->transport->splice != NULL && payload_len >= SPLICE_MIN_PAYLOAD;
+}
+
+int send_bulk(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    if (!is_bulk_spliced(executor, msg->s_header.s_payload_len)) return send(executor, dst, msg);
+    int rc = executor->transport->splice(executor, dst, msg);
+    // channel refers to the buffer now, next message to dst takes the next one
+    if (rc == 0) advance_spliced_bulk_buf(&executor->bulk, dst);
+    on_sent(executor, dst, msg, rc);
     return rc;
 }
 
@@ -64,6 +88,9 @@ int send_multicast(void *self, const Message *msg) {
         debug_ipc_send_multicast_fmt, get_lamport_time(), executor->local_id, executor->local_id,
         get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time
     );
+    if (executor->transport->multicast != NULL) {
+        return executor->transport->multicast(executor, msg);
+    }
     int rc = 0;
     for (int dst = 0; dst < executor->proc_n; ++dst) {
         if (executor->local_id == dst) continue;
@@ -73,34 +100,54 @@ int send_multicast(void *self, const Message *msg) {
     return rc;
 }
 
-int receive(void *self, local_id from, Message *msg) {
-    executor *executor = self;
-    channel_h channel_h = get_channel_read_h(executor, from);
-    if (channel_h == -1) return -1;
-    int bytes = 0;
-    if ((bytes = read(channel_h, &(msg->s_header), sizeof(MessageHeader))) <= 0) return -1;
-    if (msg->s_header.s_payload_len > 0
-        && (bytes = read(channel_h, msg->s_payload, msg->s_header.s_payload_len)) <= 0)
-        return 1;
+/**
+ * @brief      Update time with received message and print it.
+ */
+void on_received(executor *executor, local_id from, const Message *msg) {
     timestamp_t prev_time = get_lamport_time();
-    next_tick(msg->s_header.s_local_time);
+    // streamed message is received once, with its last chunk
+    if (is_stream_end(msg)) next_tick(msg->s_header.s_local_time);
     debug_ipc_print(
         debug_ipc_receive_fmt, get_lamport_time(), executor->local_id, executor->local_id, from,
-        get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time, prev_time, bytes
+        get_msg_type_text(get_stream_msg_type(msg)), msg->s_header.s_local_time, prev_time,
+        (int)compute_msg_size(msg)
     );
+}
+
+/**
+ * @brief      Receive a control message of the channel or (if only_high is not set) the first bulk
+ * message put aside.
+ */
+int receive_lane(executor *executor, local_id from, Message *msg, int only_high) {
+    // bulk messages are put aside until channel has no control messages, so control messages do
+    // not wait for data payloads sent before them (lane of bulk messages stays in FIFO order)
+    while (!is_bulk_lane_full(&executor->lanes, from)) {
+        if (executor->transport->read(executor, from, msg) != 0) break;
+        if (get_msg_lane(get_stream_msg_type(msg)) == LANE_HIGH
+            || push_bulk_msg(&executor->lanes, from, msg) != 0) {
+            on_received(executor, from, msg);
+            return 0;
+        }
+    }
+    if (only_high || pop_bulk_msg(&executor->lanes, from, msg) != 0) return -1;
+    on_received(executor, from, msg);
     return 0;
 }
 
+int receive(void *self, local_id from, Message *msg) {
+    return receive_lane(self, from, msg, 0);
+}
+
 int receive_any(void *self, Message *msg) {
     executor *executor = self;
-    int       received_n = 0;
-    local_id  local_id = 0;
-    while (received_n == 0) {
+    while (1) {
         if (executor->proc_n - 1) usleep(SLEEP_RECEIVE_USEC);
-        local_id = (local_id + 1) % executor->proc_n;
-        if (executor->local_id == local_id) continue;
-        int rc = receive(executor, local_id, msg);
-        received_n += (rc == 0);
+        // control messages of all channels are received before any bulk message
+        for (int only_high = 1; only_high >= 0; --only_high) {
+            for (local_id from = 0; from < executor->proc_n; ++from) {
+                if (executor->local_id == from) continue;
+                if (receive_lane(executor, from, msg, only_high) == 0) return 0;
+            }
+        }
     }
-    return 0;
 }
@@ -18,4 +18,27 @@
  */
 char *get_msg_type_text(const MessageType type);
 
+/**
+ * @brief      Checks if bulk message with payload_len bytes of payload is moved to transport by
+ * pages without copying (payloads of SPLICE_MIN_PAYLOAD bytes and more, if transport supports it).
+ *
+ * @param      self         Any data structure implemented by students to perform I/O
+ * @param[in]  payload_len  The payload length
+ *
+ * @return     1 if message is spliced, 0 if it is copied
+ */
+int is_bulk_spliced(void *self, uint16_t payload_len);
+
+/**
+ * @brief      Send a message allocated with new_bulk_msg. Spliced messages (see is_bulk_spliced)
+ * are not copied, so message must not be changed after call.
+ *
+ * @param      self  Any data structure implemented by students to perform I/O
+ * @param[in]  dst   ID of recepient
+ * @param[in]  msg   Message to send
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int send_bulk(void *self, local_id dst, const Message *msg);
+
 #endif  // __IFMO_DISTRIBUTED_CLASS_IPC_UTIL__H
@@ -0,0 +1,106 @@
+#include "lane.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ipc.h"
+#include "ipc_util.h"
+
+// data payloads go behind control messages unless configured otherwise
+static uint8_t msg_lanes[LANE_TYPE_N] = {
+    [TRANSFER] = LANE_BULK,
+    [BALANCE_HISTORY] = LANE_BULK,
+};
+
+/**
+ * @brief      Finds message type by name of len chars.
+ *
+ * @return     The message type or -1 if name is unknown.
+ */
+int find_msg_type(const char *name, size_t len) {
+    for (int type = 0; type < LANE_TYPE_N; ++type) {
+        const char *text = get_msg_type_text(type);
+        if (strlen(text) == len && strncmp(text, name, len) == 0) return type;
+    }
+    return -1;
+}
+
+int set_bulk_msg_types(const char *types) {
+    uint8_t lanes[LANE_TYPE_N] = {0};
+    for (const char *name = types; *name != '\0'; name += *name == ',') {
+        size_t len = strcspn(name, ",");
+        int    type = find_msg_type(name, len);
+        if (type < 0) return -1;
+        lanes[type] = LANE_BULK;
+        name += len;
+    }
+    memcpy(msg_lanes, lanes, sizeof(msg_lanes));
+    return 0;
+}
+
+MessageLane get_msg_lane(int16_t type) {
+    if (type < 0 || type >= LANE_TYPE_N) return LANE_HIGH;
+    return msg_lanes[type];
+}
+
+void init_lanes(LaneState *lanes) {
+    memset(lanes, 0, sizeof(LaneState));
+}
+
+void destroy_lanes(LaneState *lanes) {
+    for (int from = 0; from <= MAX_PROCESS_ID; ++from) {
+        LaneQueue *queue = &lanes->bulk[from];
+        while (queue->head != NULL) {
+            LaneMsg *next = queue->head->next;
+            free(queue->head);
+            queue->head = next;
+        }
+        queue->tail = NULL;
+        queue->n = 0;
+    }
+}
+
+int is_bulk_lane_full(const LaneState *lanes, local_id from) {
+    return lanes->bulk[from].n >= LANE_QUEUE_SIZE;
+}
+
+int push_bulk_msg(LaneState *lanes, local_id from, const Message *msg) {
+    LaneQueue *queue = &lanes->bulk[from];
+    size_t     size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    LaneMsg   *copy = malloc(sizeof(LaneMsg) + size);
+    if (copy == NULL) return -1;
+    copy->next = NULL;
+    memcpy(copy->data, msg, size);
+    if (queue->tail != NULL) queue->tail->next = copy;
+    else queue->head = copy;
+    queue->tail = copy;
+    queue->n++;
+    return 0;
+}
+
+int pop_bulk_msg(LaneState *lanes, local_id from, Message *msg) {
+    LaneQueue *queue = &lanes->bulk[from];
+    LaneMsg   *head = queue->head;
+    if (head == NULL) return -1;
+    const Message *copy = (const Message *)head->data;
+    memcpy(msg, copy, sizeof(MessageHeader) + copy->s_header.s_payload_len);
+    queue->head = head->next;
+    if (queue->head == NULL) queue->tail = NULL;
+    queue->n--;
+    free(head);
+    return 0;
+}
+
+void move_bulk_lane_front(LaneState *lanes, LaneState *front, local_id from) {
+    LaneQueue *queue = &lanes->bulk[from];
+    LaneQueue *moved = &front->bulk[from];
+    if (moved->head == NULL) return;
+    // moved list is linked before the head, so its first message becomes the head
+    moved->tail->next = queue->head;
+    if (queue->tail == NULL) queue->tail = moved->tail;
+    queue->head = moved->head;
+    queue->n += moved->n;
+    moved->head = moved->tail = NULL;
+    moved->n = 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file     lane.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Priority lanes of channels: control messages overtake bulk payloads
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_LANE__H
+#define __ITMO_DISTRIBUTED_CLASS_LANE__H
+
+#include <stdint.h>
+
+#include "ipc.h"
+
+#define LANE_TYPE_N     16  // size of message type to lane map (all MessageType values are less)
+#define LANE_QUEUE_SIZE 32  // max number of bulk messages read ahead of control messages
+
+typedef enum {
+    LANE_HIGH,  ///< Control messages (start, stop, ack), always received first
+    LANE_BULK,  ///< Data messages, received when there is no control message in channel
+} MessageLane;
+
+typedef struct LaneMsg {
+    struct LaneMsg *next;    ///< Next message of lane
+    char            data[];  ///< Message copy (header + payload)
+} LaneMsg;
+
+/**
+ * Bulk lane of one channel: list of message copies which are read from transport ahead of control
+ * messages and wait until channel has no control messages.
+ */
+typedef struct {
+    LaneMsg *head;  ///< First message (owned by lane)
+    LaneMsg *tail;  ///< Last message
+    uint16_t n;     ///< Number of buffered messages
+} LaneQueue;
+
+typedef struct {
+    LaneQueue bulk[MAX_PROCESS_ID + 1];  ///< Bulk lane of every reading channel
+} LaneState;
+
+/**
+ * @brief      Set message types received in bulk lane, all other types are received in high lane.
+ *
+ * @param[in]  types  Comma separated message type names (e.g. "TRANSFER,BALANCE_HISTORY"), empty
+ *                    string puts all types to high lane
+ *
+ * @return     0 on success, -1 on unknown type name
+ */
+int set_bulk_msg_types(const char *types);
+
+/**
+ * @brief      Gets the lane of message type.
+ *
+ * @param[in]  type  The message type
+ *
+ * @return     The lane (LANE_HIGH for unknown types).
+ */
+MessageLane get_msg_lane(int16_t type);
+
+/**
+ * @brief      Initializes empty lanes.
+ *
+ * @param      lanes  The lanes
+ */
+void init_lanes(LaneState *lanes);
+
+/**
+ * @brief      Frees all buffered messages.
+ *
+ * @param      lanes  The lanes
+ */
+void destroy_lanes(LaneState *lanes);
+
+/**
+ * @brief      Determines if bulk lane of channel has LANE_QUEUE_SIZE messages or more, so no more
+ * messages are read ahead of control messages.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ *
+ * @return     1 if lane is full, 0 otherwise.
+ */
+int is_bulk_lane_full(const LaneState *lanes, local_id from);
+
+/**
+ * @brief      Copies message to the tail of channel bulk lane.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ * @param[in]  msg    The message
+ *
+ * @return     0 on success, -1 if message can not be allocated.
+ */
+int push_bulk_msg(LaneState *lanes, local_id from, const Message *msg);
+
+/**
+ * @brief      Moves the head of channel bulk lane to message.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ * @param      msg    The message to write to
+ *
+ * @return     0 on success, -1 if lane is empty.
+ */
+int pop_bulk_msg(LaneState *lanes, local_id from, Message *msg);
+
+/**
+ * @brief      Moves all messages of channel bulk lane of other state before the messages of
+ * channel bulk lane (they were read from channel earlier, so they are received first). Lane can
+ * exceed LANE_QUEUE_SIZE after it, nothing is dropped.
+ *
+ * @param      lanes  The lanes
+ * @param      front  The lanes with messages to move (channel lane is empty after call)
+ * @param[in]  from   The channel source local id
+ */
+void move_bulk_lane_front(LaneState *lanes, LaneState *front, local_id from);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_LANE__H
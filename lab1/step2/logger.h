@@ -12,6 +12,9 @@
 static const char *const log_channel_opened_fmt
     = "Channel opened (%2d -> %2d) [w] -> [r] [%2d] -> [%2d]\n";
 
+static const char *const log_seqpacket_channel_opened_fmt
+    = "Channel opened (%2d <-> %2d) [s] <-> [s] [%2d] <-> [%2d] [seqpacket]\n";
+
 static const char *const log_channel_closed_fmt = "Channel closed (%2d -> %2d)\n";
 
 /**
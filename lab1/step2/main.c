@@ -12,6 +12,7 @@
 #include "debug.h"
 #include "ipc.h"
 #include "logger.h"
+#include "transport.h"
 #include "worker.h"
 
 int is_parent(pid_t parent_pid) {
@@ -20,7 +21,7 @@ int is_parent(pid_t parent_pid) {
 
 void create_child_process(
     int proc_n, pid_t parent_pid, int local_id, executor *executor, channel **channels,
-    balance_t start_balance
+    const transport *transport, balance_t start_balance
 ) {
     // fork only main parent process
     if (!is_parent(parent_pid)) return;
@@ -29,7 +30,7 @@ void create_child_process(
         // forked process
         pid_t pid = getpid();
         pid_t p_pid = getppid();
-        init_executor(executor, channels, local_id, proc_n, pid, p_pid, start_balance);
+        init_executor(executor, channels, transport, local_id, proc_n, pid, p_pid, start_balance);
         debug_print(debug_forked_fmt, pid, p_pid, local_id);
     }
 }
@@ -42,17 +43,19 @@ void create_processes(
 
     for (int local_id = 1; local_id < arguments->proc_n; ++local_id) {
         create_child_process(
-            arguments->proc_n, parent_pid, local_id, executor, channels,
+            arguments->proc_n, parent_pid, local_id, executor, channels, arguments->transport,
             arguments->start_balance[local_id - 1]
         );
     }
     if (is_parent(parent_pid)) {
-        init_executor(executor, channels, PARENT_ID, arguments->proc_n, getpid(), 0, 0);
+        init_executor(
+            executor, channels, arguments->transport, PARENT_ID, arguments->proc_n, getpid(), 0, 0
+        );
     }
     debug_print(debug_proc_created_fmt, getpid());
 }
 
-void init(int proc_n, channel ***channels) {
+void init(int proc_n, const transport *transport, channel ***channels) {
     *channels = malloc(proc_n * sizeof(channel *));
     for (int i = 0; i < proc_n; ++i) { (*channels)[i] = malloc(proc_n * sizeof(channel)); }
     debug_print(debug_malloc_ch_fin_fmt, (void *)*channels);
@@ -60,7 +63,7 @@ void init(int proc_n, channel ***channels) {
         perror("Failed to create channels");
         exit(1);
     }
-    if (open_channels(proc_n, *channels) != 0) {
+    if (transport->open(proc_n, *channels) != 0) {
         perror("Failed to open channels");
         exit(1);
     };
@@ -68,12 +71,12 @@ void init(int proc_n, channel ***channels) {
     open_events_log_f();
 }
 
-void cleanup(int proc_n, channel **channels, executor *executor) {
+void cleanup(int proc_n, const transport *transport, channel **channels, executor *executor) {
     if (executor->local_id == PARENT_ID) {
         // wait all child processes
         while (wait(NULL) > 0) {}
     }
-    close_channels(proc_n, channels);
+    transport->close(proc_n, channels);
     cleanup_executor(executor);
     for (int i = 0; i < proc_n; ++i) free(channels[i]);
     free(channels);
@@ -97,7 +100,7 @@ int main(int argc, char **argv) {
     debug_print(debug_main_args_parsed_fmt, argc, arguments.proc_n);
 
     channel **channels;
-    init(arguments.proc_n, &channels);
+    init(arguments.proc_n, arguments.transport, &channels);
 
     executor executor;
     pid_t    parent_pid = getpid();
@@ -108,6 +111,6 @@ int main(int argc, char **argv) {
     debug_print(debug_executor_info_fmt, executor.pid, executor.parent_pid, executor.local_id);
     run_worker(&executor);
 
-    cleanup(arguments.proc_n, channels, &executor);
+    cleanup(arguments.proc_n, arguments.transport, channels, &executor);
     return 0;
 }
@@ -0,0 +1,20 @@
+// MSG_DONTWAIT and MSG_NOSIGNAL are not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "packet.h"
+
+#include <sys/socket.h>
+#include <sys/types.h>
+
+int open_packet_pair(int fd[2]) {
+    return socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fd) != 0;
+}
+
+ssize_t send_packet(int fd, const void *buf, size_t size) {
+    // send is defined by ipc.h, so sendto is used
+    return sendto(fd, buf, size, MSG_DONTWAIT | MSG_NOSIGNAL, NULL, 0);
+}
+
+ssize_t recv_packet(int fd, void *buf, size_t size) {
+    return recv(fd, buf, size, MSG_DONTWAIT);
+}
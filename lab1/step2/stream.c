@@ -0,0 +1,100 @@
+#include "stream.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ipc.h"
+
+void init_streams(StreamState *streams) {
+    memset(streams, 0, sizeof(StreamState));
+}
+
+void destroy_streams(StreamState *streams) {
+    for (local_id from = 0; from <= MAX_PROCESS_ID; ++from) finish_stream(streams, from);
+}
+
+uint16_t get_chunk_len(uint32_t total_len, uint32_t offset) {
+    return total_len - offset < MAX_CHUNK_LEN ? total_len - offset : MAX_CHUNK_LEN;
+}
+
+void write_chunk(
+    Message *msg, int16_t type, const void *data, uint32_t total_len, uint32_t offset
+) {
+    ChunkHeader header = {
+        .s_type = type,
+        .s_chunk_len = get_chunk_len(total_len, offset),
+        .s_offset = offset,
+        .s_total_len = total_len,
+    };
+    memcpy(msg->s_payload, &header, sizeof(ChunkHeader));
+    memcpy(msg->s_payload + sizeof(ChunkHeader), (const char *)data + offset, header.s_chunk_len);
+}
+
+/**
+ * @brief      Copies chunk header out of message.
+ *
+ * @return     0 on success, -1 if message is not a chunk.
+ */
+int read_chunk_header(const Message *msg, ChunkHeader *header) {
+    if (msg->s_header.s_type != STREAM_CHUNK) return -1;
+    if (msg->s_header.s_payload_len < sizeof(ChunkHeader)) return -1;
+    memcpy(header, msg->s_payload, sizeof(ChunkHeader));
+    return 0;
+}
+
+int16_t get_stream_msg_type(const Message *msg) {
+    ChunkHeader header;
+    if (read_chunk_header(msg, &header) != 0) return msg->s_header.s_type;
+    return header.s_type;
+}
+
+int is_stream_end(const Message *msg) {
+    ChunkHeader header;
+    if (read_chunk_header(msg, &header) != 0) return 1;
+    return header.s_offset + header.s_chunk_len == header.s_total_len;
+}
+
+void set_stream_target(StreamState *streams, local_id from, void *target, uint32_t capacity) {
+    streams->channels[from].target = target;
+    streams->channels[from].capacity = capacity;
+}
+
+int on_stream_chunk(StreamState *streams, local_id from, const Message *msg) {
+    StreamChannel *stream = &streams->channels[from];
+    ChunkHeader    header;
+    if (read_chunk_header(msg, &header) != 0) return -1;
+    if (header.s_offset == 0) {
+        // channel is FIFO, so the first chunk means the previous stream is finished or lost
+        if (stream->data != NULL && stream->data != stream->target) free(stream->data);
+        stream->data = stream->target;
+        if (stream->data == NULL || stream->capacity < header.s_total_len) {
+            stream->data = malloc(header.s_total_len);
+        }
+        stream->received_len = 0;
+        stream->total_len = header.s_total_len;
+        stream->type = header.s_type;
+    }
+    if (stream->data == NULL || header.s_offset != stream->received_len
+        || header.s_total_len != stream->total_len
+        || header.s_offset + header.s_chunk_len > header.s_total_len
+        || sizeof(ChunkHeader) + header.s_chunk_len > msg->s_header.s_payload_len) {
+        return -1;
+    }
+    memcpy(
+        stream->data + header.s_offset, msg->s_payload + sizeof(ChunkHeader), header.s_chunk_len
+    );
+    stream->received_len += header.s_chunk_len;
+    return stream->received_len == stream->total_len;
+}
+
+const void *get_stream_data(const StreamState *streams, local_id from, uint32_t *len) {
+    *len = streams->channels[from].received_len;
+    return streams->channels[from].data;
+}
+
+void finish_stream(StreamState *streams, local_id from) {
+    StreamChannel *stream = &streams->channels[from];
+    if (stream->data != NULL && stream->data != stream->target) free(stream->data);
+    memset(stream, 0, sizeof(StreamChannel));
+}
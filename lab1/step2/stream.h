@@ -0,0 +1,141 @@
+/**
+ * @file     stream.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Messages longer than MAX_PAYLOAD_LEN sent as a stream of chunks
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_STREAM__H
+#define __ITMO_DISTRIBUTED_CLASS_STREAM__H
+
+#include <stdint.h>
+
+#include "ipc.h"
+
+#define STREAM_CHUNK 0x100  // type of message carrying a part of stream (out of MessageType range)
+
+/**
+ * Header of chunk placed before chunk bytes in message payload. Message header of every chunk
+ * keeps the Lamport time of the whole streamed message.
+ */
+typedef struct {
+    int16_t  s_type;       ///< Type of the streamed message
+    uint16_t s_chunk_len;  ///< Number of stream bytes in the chunk
+    uint32_t s_offset;     ///< Offset of chunk bytes in the stream
+    uint32_t s_total_len;  ///< Length of the whole stream
+} ChunkHeader;
+
+#define MAX_CHUNK_LEN (MAX_PAYLOAD_LEN - sizeof(ChunkHeader))
+
+/**
+ * Stream received from one channel. Chunks are copied right into the receiver buffer (target) if it
+ * is set, so the whole message is not buffered twice.
+ */
+typedef struct {
+    char    *target;        ///< Buffer the next stream is received into (NULL to allocate)
+    uint32_t capacity;      ///< Size of target buffer
+    char    *data;          ///< Buffer of stream being received (target or allocated one)
+    uint32_t received_len;  ///< Number of received bytes
+    uint32_t total_len;     ///< Length of the whole stream
+    int16_t  type;          ///< Type of the streamed message
+} StreamChannel;
+
+typedef struct {
+    StreamChannel channels[MAX_PROCESS_ID + 1];  ///< Stream of every reading channel
+} StreamState;
+
+/**
+ * @brief      Initializes state without streams.
+ *
+ * @param      streams  The streams
+ */
+void init_streams(StreamState *streams);
+
+/**
+ * @brief      Releases buffers of unfinished streams.
+ *
+ * @param      streams  The streams
+ */
+void destroy_streams(StreamState *streams);
+
+/**
+ * @brief      Gets the length of chunk which starts at offset.
+ *
+ * @param[in]  total_len  The length of the whole stream
+ * @param[in]  offset     The offset of chunk
+ *
+ * @return     The number of stream bytes in chunk.
+ */
+uint16_t get_chunk_len(uint32_t total_len, uint32_t offset);
+
+/**
+ * @brief      Writes chunk header and bytes to message payload.
+ *
+ * @param      msg        The message with payload of sizeof(ChunkHeader) + chunk length bytes
+ * @param[in]  type       The type of the streamed message
+ * @param[in]  data       The whole stream
+ * @param[in]  total_len  The length of the whole stream
+ * @param[in]  offset     The offset of chunk
+ */
+void write_chunk(Message *msg, int16_t type, const void *data, uint32_t total_len, uint32_t offset);
+
+/**
+ * @brief      Gets type of message, for chunk it is type of the streamed message.
+ *
+ * @param[in]  msg   The message
+ *
+ * @return     The message type.
+ */
+int16_t get_stream_msg_type(const Message *msg);
+
+/**
+ * @brief      Determines if message completes a message (chunk is the last one of stream or
+ * message is not a chunk).
+ *
+ * @param[in]  msg   The message
+ *
+ * @return     1 if message is complete, 0 otherwise.
+ */
+int is_stream_end(const Message *msg);
+
+/**
+ * @brief      Sets buffer the next stream from channel is received into.
+ *
+ * @param      streams   The streams
+ * @param[in]  from      The channel source local id
+ * @param      target    The buffer
+ * @param[in]  capacity  The size of buffer (longer streams are received into allocated buffer)
+ */
+void set_stream_target(StreamState *streams, local_id from, void *target, uint32_t capacity);
+
+/**
+ * @brief      Copies chunk bytes to stream of channel.
+ *
+ * @param      streams  The streams
+ * @param[in]  from     The channel source local id
+ * @param[in]  msg      The chunk message
+ *
+ * @return     1 if stream is complete (see get_stream_data), 0 if more chunks are expected, -1 on
+ * error (chunk is out of order or buffer can not be allocated)
+ */
+int on_stream_chunk(StreamState *streams, local_id from, const Message *msg);
+
+/**
+ * @brief      Gets complete stream of channel (valid until finish_stream).
+ *
+ * @param      streams  The streams
+ * @param[in]  from     The channel source local id
+ * @param      len      The length of stream
+ *
+ * @return     The stream bytes.
+ */
+const void *get_stream_data(const StreamState *streams, local_id from, uint32_t *len);
+
+/**
+ * @brief      Releases stream of channel (and its target), so the next stream can be received.
+ *
+ * @param      streams  The streams
+ * @param[in]  from     The channel source local id
+ */
+void finish_stream(StreamState *streams, local_id from);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_STREAM__H
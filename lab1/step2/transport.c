@@ -0,0 +1,20 @@
+#include "transport.h"
+
+#include <stddef.h>
+#include <string.h>
+
+static const transport *const transports[] = {
+    &pipe_transport,
+    &seqpacket_transport,
+};
+
+const transport *find_transport(const char *name) {
+    for (size_t i = 0; i < sizeof(transports) / sizeof(transports[0]); ++i) {
+        if (strcmp(transports[i]->name, name) == 0) return transports[i];
+    }
+    return NULL;
+}
+
+const transport *get_default_transport() {
+    return &pipe_transport;
+}
@@ -13,6 +13,7 @@
 #include "ipc.h"
 #include "logger.h"
 #include "pa2345.h"
+#include "stream.h"
 #include "time.h"
 
 void account_start(executor *self) {
@@ -158,10 +159,11 @@ void account_done(executor *self) {
     wait_receive_all_child_msg_by_type(self, DONE, NULL);
     log_events_msg(log_received_all_done_fmt, get_lamport_time(), self->local_id);
 
-    Message msg;
-    construct_msg(&msg, BALANCE_HISTORY, sizeof(BalanceHistory));
-    serialize_struct(&msg, self->bank_account.history, sizeof(BalanceHistory));
-    tick_send(self, PARENT_ID, &msg);
+    // only filled states of history are sent, stream is not limited by message length
+    BalanceHistory *history = self->bank_account.history;
+    uint32_t        len = offsetof(BalanceHistory, s_history)
+                 + history->s_history_len * sizeof(BalanceState);
+    tick_send_stream(self, PARENT_ID, BALANCE_HISTORY, history, len);
 }
 
 void account_worker(executor *self) {
@@ -174,14 +176,16 @@ void account_worker(executor *self) {
     account_done(self);
 }
 
-void on_balance_history(executor *self, Message *msg, local_id from) {
-    BalanceHistory history;
-    deserialize_struct(msg, &history, sizeof(BalanceHistory));
+void on_balance_history(executor *self, const void *data, uint32_t len, local_id from) {
+    // from - 1 because children id starts from 1
+    BalanceHistory *history = &self->bank_account.all_history->s_history[from - 1];
+    // stream is received right into history unless it does not fit
+    if (data != history) {
+        memcpy(history, data, len < sizeof(BalanceHistory) ? len : sizeof(BalanceHistory));
+    }
     debug_worker_print(
-        debug_worker_on_hist_fmt, get_lamport_time(), self->local_id, from, history.s_history_len
+        debug_worker_on_hist_fmt, get_lamport_time(), self->local_id, from, history->s_history_len
     );
-    // from - 1 because children id starts from 1
-    self->bank_account.all_history->s_history[from - 1] = history;
 }
 
 /**
@@ -246,7 +250,13 @@ void router_worker(executor *self) {
     log_events_msg(log_received_all_done_fmt, get_lamport_time(), self->local_id);
     // TODO: get history
 
-    wait_receive_all_child_msg_by_type(self, BALANCE_HISTORY, on_balance_history);
+    for (local_id child = 1; child < self->proc_n; ++child) {
+        set_stream_target(
+            &self->streams, child, &self->bank_account.all_history->s_history[child - 1],
+            sizeof(BalanceHistory)
+        );
+    }
+    wait_receive_all_child_stream_by_type(self, BALANCE_HISTORY, on_balance_history);
     fill_trailling_history(self->bank_account.all_history);
     print_history(self->bank_account.all_history);
 
@@ -260,14 +270,18 @@ void run_worker(executor *self) {
 }
 
 void init_executor(
-    executor *executor, channel **channels, local_id local_id, int proc_n, pid_t pid, pid_t p_pid,
-    balance_t start_balance
+    executor *executor, channel **channels, const transport *transport, local_id local_id,
+    int proc_n, pid_t pid, pid_t p_pid, balance_t start_balance
 ) {
     executor->local_id = local_id;
+    executor->transport = transport;
     executor->proc_n = proc_n;
     executor->pid = pid;
     executor->parent_pid = p_pid;
     executor->is_running = 1;
+    init_lanes(&executor->lanes);
+    init_streams(&executor->streams);
+    init_bulk_buffers(&executor->bulk);
 
     executor->bank_account.balance = start_balance;
     if (local_id == PARENT_ID) {
@@ -288,13 +302,15 @@ void init_executor(
         executor->bank_account.all_history = NULL;
     }
 
-    set_executor_channels(proc_n, executor, channels);
-    close_unused_channels(proc_n, local_id, channels);
+    transport->set_executor(proc_n, executor, channels);
+    transport->close_unused(proc_n, local_id, channels);
 }
 
 void cleanup_executor(executor *executor) {
     if (executor->bank_account.all_history != NULL) free(executor->bank_account.all_history);
     if (executor->bank_account.history != NULL) free(executor->bank_account.history);
-    free(executor->ch_read);
-    free(executor->ch_write);
+    executor->transport->cleanup(executor);
+    destroy_lanes(&executor->lanes);
+    destroy_streams(&executor->streams);
+    destroy_bulk_buffers(&executor->bulk);
 }
@@ -14,6 +14,7 @@
 #include "channels.h"
 #include "executor.h"
 #include "ipc.h"
+#include "transport.h"
 
 /**
  * @brief      Child worker main logic
@@ -41,6 +42,7 @@ void run_worker(executor *self);
  *
  * @param      executor       The executor
  * @param      channels       The channels matrix
+ * @param[in]  transport      The transport backend
  * @param[in]  local_id       The local identifier
  * @param[in]  proc_n         The number of processes
  * @param[in]  pid            The pid of executor
@@ -48,8 +50,8 @@ void run_worker(executor *self);
  * @param[in]  start_balance  The start balance of bank account
  */
 void init_executor(
-    executor *executor, channel **channels, local_id local_id, int proc_n, pid_t pid, pid_t p_pid,
-    balance_t start_balance
+    executor *executor, channel **channels, const transport *transport, local_id local_id,
+    int proc_n, pid_t pid, pid_t p_pid, balance_t start_balance
 );
 
 /**
@@ -6,6 +6,10 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "lane.h"
+#include "shm.h"
+#include "tree.h"
+
 #define MAX_BALANCE 65535
 
 const char *argp_program_version = "pa1";
@@ -20,17 +24,49 @@ static char args_doc[] = "";
 
 /* The options we understand. */
 static struct argp_option options[] = {
-    {"process", 'p', "NUMBER OF PROCESSES", 0, "Amount of processes (2-15)"},
+    {"process", 'p', "NUMBER OF PROCESSES", 0, "Amount of processes (2-1024)"},
     {"debug", 'd', 0, OPTION_ARG_OPTIONAL, "Enable debug messages"},
     {"debug-ipc", 'i', 0, OPTION_ARG_OPTIONAL, "Enable debug messages for IPC"},
     {"debug-time", 't', 0, OPTION_ARG_OPTIONAL, "Enable debug messages for TIME"},
     {"debug-worker", 'w', 0, OPTION_ARG_OPTIONAL, "Enable debug messages for WORKER"},
     {"mutexl", 'l', 0, OPTION_ARG_OPTIONAL, "Enable Mutex lock"},
+    {"coroutines", 'c', 0, OPTION_ARG_OPTIONAL,
+     "Run executors as coroutines of one thread (default transport: shm)"},
+    {"threads", 'r', 0, OPTION_ARG_OPTIONAL,
+     "Run executors as threads of one process (default transport: shm)"},
+    {"transport", 'T', "NAME", 0,
+     "Transport backend (pipe, shm, inbox, uring, seqpacket, tcp, sim, lazy). Default: pipe"},
+    {"wait", 'W', "POLICY", 0,
+     "Wait policy (block, spin, backoff, spin-block, sleep). Default: block"},
+    {"nodes", 'N', "FILE", 0, "Node map for tcp transport (\"local_id host:port\" lines)"},
+    {"sim", 'S', "OPTIONS", 0,
+     "Options of sim transport, comma separated: latency=USEC, jitter=USEC, bandwidth=BYTES, "
+     "seed=N, links=FILE"},
+    {"bulk", 'B', "TYPES", 0,
+     "Message types received after control messages, comma separated. "
+     "Default: TRANSFER,BALANCE_HISTORY"},
+    {"fanout", 'K', "K", 0,
+     "Route messages over K-ary tree of processes, every process forwards multicast messages to "
+     "its children (0 - sender writes to every process). Default: 0"},
     {0}
 };
 
 static const char *argp_err_key_nan_fmt = "-%c is not a number. See --help for more information";
 static const char *arg_err_key_required_fmt = "-%c is required. See --help for more information";
+static const char *arg_err_key_transport_fmt
+    = "-%c unknown transport '%s'. See --help for more information";
+static const char *arg_err_key_threads_fmt
+    = "-%c transport '%s' can not be used with threads or coroutines. See --help for more "
+      "information";
+static const char *arg_err_key_conflict_fmt
+    = "-%c can not be used together with -%c. See --help for more information";
+static const char *arg_err_key_wait_fmt
+    = "-%c unknown wait policy '%s'. See --help for more information";
+static const char *arg_err_key_msg_type_fmt
+    = "-%c unknown message type in '%s'. See --help for more information";
+static const char *arg_err_key_shm_fmt
+    = "-%c transport 'shm' needs %zu MB of shared memory for %d processes (limit is %lu MB). Use "
+      "less processes or other transport";
 static const char *arg_err_key_range_fmt
     = "-%c value is not in correct range. See --help for more information";
 
@@ -47,6 +83,7 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
     /* Get the input argument from argp_parse, which we
        know is a pointer to our arguments structure. */
     arguments *arguments = state->input;
+    uint8_t    is_shared = 0;  // executors share one process (threads or coroutines)
 
     switch (key) {
         case 'p': {
@@ -64,12 +101,12 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
                 argp_failure(state, 1, 0, argp_err_key_nan_fmt, key);
                 return ARGP_ERR_UNKNOWN;
             }
-            if (proc_n < 2 || proc_n > 15) {
+            if (proc_n < 2 || proc_n > MAX_PROCESS_ID) {
                 // not in range
                 argp_failure(state, 1, 0, arg_err_key_range_fmt, key);
                 return ARGP_ERR_UNKNOWN;
             }
-            arguments->proc_n = (uint8_t)proc_n + 1;
+            arguments->proc_n = (uint16_t)proc_n + 1;
             break;
         }
 
@@ -96,7 +133,89 @@ static error_t parse_opt(int key, char *arg, struct argp_state *state) {
             arguments->use_lock = 1;
             break;
 
+        case 'c':
+            arguments->use_coroutines = 1;
+            break;
+
+        case 'r':
+            arguments->use_threads = 1;
+            break;
+
+        case 'T':
+            arguments->transport = find_transport(arg);
+            if (arguments->transport == NULL) {
+                argp_failure(state, 1, 0, arg_err_key_transport_fmt, key, arg);
+                return ARGP_ERR_UNKNOWN;
+            }
+            break;
+
+        case 'W':
+            arguments->wait_policy = find_wait_policy(arg);
+            if (arguments->wait_policy == NULL) {
+                argp_failure(state, 1, 0, arg_err_key_wait_fmt, key, arg);
+                return ARGP_ERR_UNKNOWN;
+            }
+            break;
+
+        case 'N':
+            arguments->nodes_path = arg;
+            break;
+
+        case 'S':
+            arguments->sim_options = arg;
+            break;
+
+        case 'B':
+            if (set_bulk_msg_types(arg) != 0) {
+                argp_failure(state, 1, 0, arg_err_key_msg_type_fmt, key, arg);
+                return ARGP_ERR_UNKNOWN;
+            }
+            break;
+
+        case 'K': {
+            char    *endptr = NULL;
+            long int fanout = strtol(arg, &endptr, 10);
+            if (*endptr != 0) {
+                argp_failure(state, 1, 0, argp_err_key_nan_fmt, key);
+                return ARGP_ERR_UNKNOWN;
+            }
+            if (fanout < 0 || fanout > MAX_PROCESS_ID) {
+                argp_failure(state, 1, 0, arg_err_key_range_fmt, key);
+                return ARGP_ERR_UNKNOWN;
+            }
+            set_tree_fanout((int)fanout);
+            break;
+        }
+
         case ARGP_KEY_END:
+            if (arguments->use_threads && arguments->use_coroutines) {
+                argp_failure(state, 1, 0, arg_err_key_conflict_fmt, 'c', 'r');
+            }
+            // simulated network runs executors as coroutines on its clock
+            if (arguments->transport != NULL && arguments->transport->is_simulated) {
+                if (arguments->use_threads) {
+                    argp_failure(state, 1, 0, arg_err_key_conflict_fmt, 'T', 'r');
+                }
+                arguments->use_coroutines = 1;
+            }
+            // default transport depends on executors kind
+            is_shared = arguments->use_threads || arguments->use_coroutines;
+            if (arguments->transport == NULL) {
+                arguments->transport
+                    = is_shared ? get_default_thread_transport() : get_default_transport();
+            }
+            if (is_shared && !arguments->transport->is_thread_safe) {
+                argp_failure(state, 1, 0, arg_err_key_threads_fmt, 'T', arguments->transport->name);
+            }
+            // rings of every pair of processes are mapped at once, refuse before fork
+            if (arguments->transport == &shm_transport
+                && !is_shm_proc_n_supported(arguments->proc_n)) {
+                argp_failure(
+                    state, 1, 0, arg_err_key_shm_fmt, 'p',
+                    get_shm_region_size(arguments->proc_n) >> 20, arguments->proc_n - 1,
+                    SHM_REGION_LIMIT >> 20
+                );
+            }
             // check if not enough args
             if (arguments->proc_n == 0) {
                 argp_failure(state, 1, 0, arg_err_key_required_fmt, 'p');
@@ -119,6 +238,12 @@ void init_defaults(arguments *arguments) {
     arguments->debug_time = 0;
     arguments->debug_worker = 0;
     arguments->use_lock = 0;
+    arguments->use_threads = 0;
+    arguments->use_coroutines = 0;
+    arguments->transport = NULL;
+    arguments->nodes_path = NULL;
+    arguments->sim_options = NULL;
+    arguments->wait_policy = get_default_wait_policy();
 }
 
 void args_parse(int argc, char **argv, arguments *arguments) {
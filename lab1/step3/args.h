@@ -11,15 +11,23 @@
 #include <stdint.h>
 
 #include "ipc.h"
+#include "transport.h"
+#include "wait.h"
 
 /* Used by main to communicate with parse_opt. */
 typedef struct {
-    uint8_t proc_n;
-    uint8_t debug;
-    uint8_t debug_ipc;
-    uint8_t debug_time;
-    uint8_t debug_worker;
-    uint8_t use_lock;
+    uint16_t           proc_n;
+    uint8_t            debug;
+    uint8_t            debug_ipc;
+    uint8_t            debug_time;
+    uint8_t            debug_worker;
+    uint8_t            use_lock;
+    uint8_t            use_threads;
+    uint8_t            use_coroutines;
+    const transport   *transport;
+    const char        *nodes_path;
+    const char        *sim_options;
+    const wait_policy *wait_policy;
 } arguments;
 
 /**
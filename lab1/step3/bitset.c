@@ -0,0 +1,28 @@
+#include "bitset.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+bitset_word *new_bitset(int bits_n) {
+    return calloc(BITSET_WORDS(bits_n), sizeof(bitset_word));
+}
+
+void set_bit(bitset_word *set, int bit) {
+    set[bit / BITSET_WORD_BITS] |= (bitset_word)1 << (bit % BITSET_WORD_BITS);
+}
+
+int is_bit_set(const bitset_word *set, int bit) {
+    return (set[bit / BITSET_WORD_BITS] >> (bit % BITSET_WORD_BITS)) & 1;
+}
+
+int count_bits(const bitset_word *set, int bits_n) {
+    int count = 0;
+    int words_n = bits_n / BITSET_WORD_BITS;
+    for (int i = 0; i < words_n; ++i) count += __builtin_popcountll(set[i]);
+    // last word may contain bits out of range
+    if (bits_n % BITSET_WORD_BITS != 0) {
+        bitset_word mask = ((bitset_word)1 << (bits_n % BITSET_WORD_BITS)) - 1;
+        count += __builtin_popcountll(set[words_n] & mask);
+    }
+    return count;
+}
@@ -0,0 +1,57 @@
+/**
+ * @file     bitset.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Word-packed sets of process local ids
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_BITSET__H
+#define __ITMO_DISTRIBUTED_CLASS_BITSET__H
+
+#include <stdint.h>
+
+#include "ipc.h"
+
+typedef uint64_t bitset_word;
+
+#define BITSET_WORD_BITS 64
+#define BITSET_WORDS(n)  (((n) + BITSET_WORD_BITS - 1) / BITSET_WORD_BITS)
+#define BITSET_MAX_WORDS BITSET_WORDS(MAX_PROCESS_ID + 1)  // words for a set of any process ids
+
+/**
+ * @brief      Allocates an empty set.
+ *
+ * @param[in]  bits_n  The number of bits
+ *
+ * @return     The set (free with free) or NULL if it can not be allocated.
+ */
+bitset_word *new_bitset(int bits_n);
+
+/**
+ * @brief      Adds bit to the set.
+ *
+ * @param      set   The set
+ * @param[in]  bit   The bit
+ */
+void set_bit(bitset_word *set, int bit);
+
+/**
+ * @brief      Determines if bit is in the set.
+ *
+ * @param      set   The set
+ * @param[in]  bit   The bit
+ *
+ * @return     1 if bit is set, 0 otherwise.
+ */
+int is_bit_set(const bitset_word *set, int bit);
+
+/**
+ * @brief      Counts bits of the set which are less than bits_n.
+ *
+ * @param      set     The set
+ * @param[in]  bits_n  The number of bits to count in
+ *
+ * @return     The number of set bits.
+ */
+int count_bits(const bitset_word *set, int bits_n);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_BITSET__H
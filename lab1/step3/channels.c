@@ -1,15 +1,23 @@
 #include "channels.h"
 
+#include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "debug.h"
 #include "executor.h"
 #include "ipc.h"
+#include "lazy.h"
 #include "logger.h"
+#include "transport.h"
 
 int init_channel(channel *channel) {
     int fd[2];
@@ -43,7 +51,7 @@ int open_channel(channel **channels, local_id from, local_id dst) {
     return rc;
 }
 
-int open_channels(int8_t proc_n, channel **channels) {
+int open_channels(int16_t proc_n, channel **channels) {
     debug_print(debug_channel_open_start_fmt, proc_n);
     for (int local_id = 0; local_id < proc_n; ++local_id) {
         for (int other_id = 0; other_id < proc_n; ++other_id) {
@@ -70,7 +78,7 @@ int close_channel(channel **channels, local_id from, local_id dst) {
     return 0;
 }
 
-int close_channels(int8_t proc_n, channel **channels) {
+int close_channels(int16_t proc_n, channel **channels) {
     for (int from = 0; from < proc_n; ++from) {
         for (int dst = 0; dst < proc_n; ++dst) {
             if (from == dst) continue;
@@ -81,7 +89,7 @@ int close_channels(int8_t proc_n, channel **channels) {
     return 0;
 }
 
-int close_unused_channels(int8_t proc_n, local_id local_id, channel **channels) {
+int close_unused_channels(int16_t proc_n, local_id local_id, channel **channels) {
     // closed unused pipes. Like in example
     // https://www.man7.org/linux/man-pages/man2/pipe.2.html#EXAMPLES proc with
     // local_id uses only local_id -> other_id write side other_id -> local_id
@@ -103,13 +111,12 @@ int close_unused_channels(int8_t proc_n, local_id local_id, channel **channels)
     return 0;
 }
 
-void set_executor_channels(int8_t proc_n, void *self, channel **channels) {
+void set_executor_handlers(int16_t proc_n, void *self, channel **channels) {
     executor *executor = self;
     local_id  local_id = executor->local_id;
 
     executor->ch_read = malloc(proc_n * sizeof(channel_h));
     executor->ch_write = malloc(proc_n * sizeof(channel_h));
-
     executor->ch_read[local_id] = 0;
     executor->ch_write[local_id] = 0;
 
@@ -131,6 +138,421 @@ void set_executor_channels(int8_t proc_n, void *self, channel **channels) {
     }
 }
 
+void init_pipe_state(PipeState *state, int16_t proc_n) {
+    state->in = calloc(proc_n, sizeof(ChannelBuffer));
+    state->out = calloc(proc_n, sizeof(OutboundBuffer));
+    state->backlog = calloc(proc_n, sizeof(PendingQueue));
+    state->borrowed_from = -1;
+}
+
+void set_executor_channels(int16_t proc_n, void *self, channel **channels) {
+    executor  *executor = self;
+    PipeState *state = malloc(sizeof(PipeState));
+    init_pipe_state(state, proc_n);
+    executor->transport_state = state;
+    set_executor_handlers(proc_n, executor, channels);
+    if (init_channels_poll(executor) != 0) perror("Failed to init channels poll");
+}
+
+#define POLL_WRITE_TAG 0x10000  // epoll data tag for writing pipe handlers
+
+int ctl_channel_poll(void *self, int op, local_id from) {
+    executor          *executor = self;
+    struct epoll_event event = {.events = EPOLLIN, .data.u32 = from};
+    if (epoll_ctl(executor->poll_h, op, executor->ch_read[from], &event) != 0) return 1;
+    executor->poll_n += op == EPOLL_CTL_ADD ? 1 : -1;
+    return 0;
+}
+
+/**
+ * @brief      Write buffered bytes of pipe self -> dst and extra bytes after them with one call.
+ * Bytes which are not written (e.g. pipe is full) are kept in the buffer.
+ *
+ * @param      executor    The executor
+ * @param[in]  dst         The destination process local id
+ * @param[in]  extra       The extra bytes (nullable)
+ * @param[in]  extra_size  The extra bytes size
+ *
+ * @return     0 on success (extra bytes are written or buffered), 1 if extra bytes are dropped
+ */
+int flush_outbound(executor *executor, local_id dst, const void *extra, size_t extra_size) {
+    PipeState      *state = executor->transport_state;
+    OutboundBuffer *out = &state->out[dst];
+    if (out->size + extra_size == 0) return 0;
+    struct iovec iov[2] = {
+        {.iov_base = out->data, .iov_len = out->size},
+        {.iov_base = (void *)extra, .iov_len = extra_size},
+    };
+    ssize_t bytes = writev(get_channel_write_h(executor, dst), iov, extra_size > 0 ? 2 : 1);
+    debug_ipc_print(debug_channel_flush_fmt, executor->local_id, dst, (int)bytes, out->size);
+    if (bytes < 0) bytes = 0;
+    if ((size_t)bytes < out->size) {
+        // keep the rest of buffered frames, extra frame goes after them
+        memmove(out->data, out->data + bytes, out->size - bytes);
+        out->size -= bytes;
+        if (out->size + extra_size > OUTBOUND_BUFFER_SIZE) return 1;
+        memcpy(out->data + out->size, extra, extra_size);
+        out->size += extra_size;
+        return 0;
+    }
+    // buffer is written, keep the rest of extra frame
+    size_t extra_written = bytes - out->size;
+    memcpy(out->data, (const char *)extra + extra_written, extra_size - extra_written);
+    out->size = extra_size - extra_written;
+    return 0;
+}
+
+/**
+ * @brief      Add or remove pipe self -> dst write handler from the executor poll. Handler is
+ * polled while there are not written bytes, so they are written as soon as the pipe is writable.
+ */
+void update_write_poll(executor *executor, local_id dst) {
+    PipeState      *state = executor->transport_state;
+    OutboundBuffer *out = &state->out[dst];
+    uint8_t         is_needed = out->size > 0;
+    if (out->pending.is_polled == is_needed) return;
+    struct epoll_event event = {.events = EPOLLOUT, .data.u32 = dst | POLL_WRITE_TAG};
+    int                op = is_needed ? EPOLL_CTL_ADD : EPOLL_CTL_DEL;
+    if (epoll_ctl(executor->poll_h, op, get_channel_write_h(executor, dst), &event) != 0) return;
+    out->pending.is_polled = is_needed;
+}
+
+int push_pending(PendingQueue *pending, const void *frame, uint32_t size) {
+    PendingFrame *item = malloc(sizeof(PendingFrame) + size);
+    if (item == NULL) return 1;
+    item->next = NULL;
+    item->size = size;
+    memcpy(item->data, frame, size);
+    if (pending->tail == NULL) pending->head = item;
+    else pending->tail->next = item;
+    pending->tail = item;
+    pending->n++;
+    pending->bytes += size;
+    pending->total_n++;
+    if (pending->n > pending->max_n) pending->max_n = pending->n;
+    return 0;
+}
+
+void pop_pending(PendingQueue *pending) {
+    PendingFrame *item = pending->head;
+    if (item == NULL) return;
+    pending->head = item->next;
+    if (pending->head == NULL) pending->tail = NULL;
+    pending->n--;
+    pending->bytes -= item->size;
+    free(item);
+}
+
+/**
+ * @brief      Move pending frames into the outbound buffer while they fit.
+ */
+void refill_outbound(OutboundBuffer *out) {
+    while (out->pending.head != NULL && out->size + out->pending.head->size <= OUTBOUND_BUFFER_SIZE
+    ) {
+        memcpy(out->data + out->size, out->pending.head->data, out->pending.head->size);
+        out->size += out->pending.head->size;
+        pop_pending(&out->pending);
+    }
+}
+
+/**
+ * @brief      Write buffered and pending frames of pipe self -> dst until the pipe is full.
+ *
+ * @return     0 if everything is written, 1 if some bytes are still not written
+ */
+int flush_channel(void *self, local_id dst) {
+    executor       *executor = self;
+    PipeState      *state = executor->transport_state;
+    OutboundBuffer *out = &state->out[dst];
+    refill_outbound(out);
+    while (out->size > 0) {
+        flush_outbound(executor, dst, NULL, 0);
+        // pipe is full, wait until it is writable
+        if (out->size > 0) break;
+        refill_outbound(out);
+    }
+    update_write_poll(executor, dst);
+    return out->size > 0;
+}
+
+/**
+ * @brief      Drop all not written bytes of pipe self -> dst (reader is closed).
+ */
+void drop_outbound(void *self, local_id dst) {
+    executor       *executor = self;
+    PipeState      *state = executor->transport_state;
+    OutboundBuffer *out = &state->out[dst];
+    while (out->pending.head != NULL) pop_pending(&out->pending);
+    out->size = 0;
+    update_write_poll(executor, dst);
+}
+
+void wait_pending_writable(
+    void *self, local_id dst, const PendingQueue *pending, uint32_t pending_limit,
+    const PendingWaitOps *ops
+) {
+    executor     *executor = self;
+    struct pollfd pfds[MAX_PROCESS_ID + 2];
+    local_id      ids[MAX_PROCESS_ID + 2];
+    uint8_t       is_closed[MAX_PROCESS_ID + 1] = {0};
+    while (ops->flush(executor, dst) != 0 && pending->bytes >= pending_limit) {
+        int pfds_n = 1;
+        pfds[0].fd = get_channel_write_h(executor, dst);
+        pfds[0].events = POLLOUT;
+        for (local_id from = 0; from < executor->proc_n; ++from) {
+            channel_h channel_h = get_channel_read_h(executor, from);
+            if (from == executor->local_id || channel_h == -1 || is_closed[from]) continue;
+            if (executor->poll_state[from] == POLL_CLOSED) continue;
+            // inbox read handler is shared by all senders, so it is polled once
+            if (pfds_n > 1 && pfds[pfds_n - 1].fd == channel_h) continue;
+            pfds[pfds_n].fd = channel_h;
+            pfds[pfds_n].events = POLLIN;
+            ids[pfds_n++] = from;
+        }
+        if (poll(pfds, pfds_n, POLL_BLOCK) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        for (int i = 1; i < pfds_n; ++i) {
+            if (!(pfds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            if (ops->drain(executor, ids[i]) == 0) continue;
+            for (local_id from = 0; from < executor->proc_n; ++from) {
+                is_closed[from] |= get_channel_read_h(executor, from) == pfds[i].fd;
+            }
+        }
+        if (pfds[0].revents & (POLLERR | POLLHUP)) {
+            ops->drop(executor, dst);
+            return;
+        }
+    }
+}
+
+int flush_channels(void *self) {
+    executor  *executor = self;
+    PipeState *state = executor->transport_state;
+    int        rc = 0;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (state->out[dst].size == 0) continue;
+        rc |= flush_channel(executor, dst);
+    }
+    return rc;
+}
+
+const PendingWaitOps pipe_wait_ops = {
+    .flush = flush_channel,
+    .drop = drop_outbound,
+    .drain = drain_channel,
+};
+
+int write_channel(void *self, local_id dst, const Message *msg) {
+    executor       *executor = self;
+    PipeState      *state = executor->transport_state;
+    OutboundBuffer *out = &state->out[dst];
+    size_t          msg_size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    int             rc = 0;
+    if (out->pending.n > 0) {
+        // keep order: message goes after already pending ones
+        rc = push_pending(&out->pending, msg, msg_size);
+        flush_channel(executor, dst);
+    } else if (out->size + msg_size > OUTBOUND_BUFFER_SIZE) {
+        // buffer is full, so write buffered messages and this one together
+        if (flush_outbound(executor, dst, msg, msg_size) != 0) {
+            rc = push_pending(&out->pending, msg, msg_size);
+        }
+        update_write_poll(executor, dst);
+    } else {
+        memcpy(out->data + out->size, msg, msg_size);
+        out->size += msg_size;
+        if (out->size >= OUTBOUND_FLUSH_SIZE) flush_channel(executor, dst);
+    }
+    if (out->pending.bytes >= PENDING_HIGH_WATER) {
+        out->pending.waits_n++;
+        debug_ipc_print(debug_channel_high_water_fmt, executor->local_id, dst, out->pending.bytes);
+        wait_pending_writable(executor, dst, &out->pending, PENDING_HIGH_WATER, &pipe_wait_ops);
+    }
+    return rc;
+}
+
+int init_channels_poll(void *self) {
+    executor *executor = self;
+    executor->poll_n = 0;
+    executor->poll_h = epoll_create1(EPOLL_CLOEXEC);
+    if (executor->poll_h < 0) return 1;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        executor->poll_state[from] = POLL_CLOSED;
+        if (from == executor->local_id) continue;
+        if (ctl_channel_poll(executor, EPOLL_CTL_ADD, from) != 0) return 1;
+        executor->poll_state[from] = POLL_ACTIVE;
+        debug_print(debug_channel_poll_fmt, executor->local_id, from, executor->ch_read[from]);
+    }
+    return 0;
+}
+
+void close_channels_poll(void *self) {
+    executor *executor = self;
+    close_channel_handler(&executor->poll_h);
+    executor->poll_n = 0;
+}
+
+void cleanup_executor_channels(void *self) {
+    executor  *executor = self;
+    PipeState *state = executor->transport_state;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst == executor->local_id) continue;
+        PendingQueue *pending = &state->out[dst].pending;
+        // messages must be delivered before exit (unless the reader is closed)
+        wait_pending_writable(executor, dst, pending, 0, &pipe_wait_ops);
+        if (pending->total_n == 0) continue;
+        debug_ipc_print(
+            debug_channel_pending_stats_fmt, executor->local_id, dst, pending->total_n,
+            pending->max_n, pending->waits_n
+        );
+    }
+    close_channels_poll(executor);
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        while (state->backlog[from].head != NULL) pop_pending(&state->backlog[from]);
+    }
+    free(state->in);
+    free(state->out);
+    free(state->backlog);
+    free(state);
+    free(executor->ch_read);
+    free(executor->ch_write);
+}
+
+/**
+ * @brief      Gets the channel buffer for pipe from -> self.
+ */
+ChannelBuffer *get_channel_buffer(executor *executor, local_id from) {
+    PipeState *state = executor->transport_state;
+    return &state->in[from];
+}
+
+uint32_t get_buffered_frame_size(ChannelBuffer *buffer) {
+    MessageHeader header;
+    uint32_t      available = buffer->end - buffer->start;
+    if (available < sizeof(MessageHeader)) return 0;
+    memcpy(&header, buffer->data + buffer->start, sizeof(MessageHeader));
+    uint32_t frame_size = sizeof(MessageHeader) + header.s_payload_len;
+    return available >= frame_size ? frame_size : 0;
+}
+
+/**
+ * @brief      Read all available bytes from pipe into channel buffer (incomplete frame is moved to
+ * the buffer beginning first).
+ *
+ * @return     Number of read bytes, 0 on closed pipe, -1 if nothing to read or on error
+ */
+ssize_t fill_channel_buffer(executor *executor, local_id from) {
+    ChannelBuffer *buffer = get_channel_buffer(executor, from);
+    channel_h      channel_h = get_channel_read_h(executor, from);
+    if (channel_h == -1) return -1;
+    if (buffer->start > 0) {
+        memmove(buffer->data, buffer->data + buffer->start, buffer->end - buffer->start);
+        buffer->end -= buffer->start;
+        buffer->start = 0;
+    }
+    ssize_t bytes = read(channel_h, buffer->data + buffer->end, CHANNEL_BUFFER_SIZE - buffer->end);
+    if (bytes > 0) buffer->end += bytes;
+    if (bytes == 0 && executor->poll_state[from] != POLL_CLOSED) {
+        // end of file: socket stays readable after it, so it is removed from poll here
+        if (executor->poll_state[from] == POLL_ACTIVE) {
+            ctl_channel_poll(executor, EPOLL_CTL_DEL, from);
+        }
+        executor->poll_state[from] = POLL_CLOSED;
+    }
+    debug_ipc_print(debug_channel_fill_fmt, executor->local_id, from, (int)bytes, buffer->end);
+    return bytes;
+}
+
+/**
+ * @brief      Collect channels which have complete frames in buffers and not masked.
+ *
+ * @return     Number of ready channels
+ */
+int get_buffered_ready(executor *executor, local_id *ready) {
+    PipeState *state = executor->transport_state;
+    int        ready_n = 0;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (from == executor->local_id || executor->poll_state[from] == POLL_MASKED) continue;
+        ChannelBuffer *buffer = get_channel_buffer(executor, from);
+        if (state->backlog[from].head != NULL || get_buffered_frame_size(buffer) > 0) {
+            ready[ready_n++] = from;
+        }
+    }
+    return ready_n;
+}
+
+int wait_pipes_ready(void *self, local_id *ready, int timeout) {
+    executor          *executor = self;
+    struct epoll_event events[MAX_PROCESS_ID + 1];
+    // messages already read into buffers are not visible for epoll
+    int                ready_n = get_buffered_ready(executor, ready);
+    int                buffered_n = ready_n;
+    do {
+        if (executor->poll_n == 0) return ready_n > 0 ? ready_n : -1;
+        int events_n
+            = epoll_wait(executor->poll_h, events, executor->proc_n, ready_n > 0 ? 0 : timeout);
+        if (events_n < 0 && errno == EINTR) continue;
+        if (events_n < 0) return -1;
+        if (events_n == 0) return ready_n;
+        for (int i = 0; i < events_n; ++i) {
+            if (events[i].data.u32 == POLL_BROKER_TAG) {
+                // lazy channels are granted or closed by the broker
+                if (accept_lazy_grants(executor) != 0) return -1;
+                continue;
+            }
+            if (events[i].data.u32 & POLL_WRITE_TAG) {
+                // pipe with not written messages became writable (or its reader is closed)
+                local_id dst = events[i].data.u32 & ~POLL_WRITE_TAG;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) drop_outbound(executor, dst);
+                else flush_channel(executor, dst);
+                continue;
+            }
+            local_id from = events[i].data.u32;
+            if (!(events[i].events & EPOLLIN)) {
+                // write side is closed and there is nothing to read anymore
+                ctl_channel_poll(executor, EPOLL_CTL_DEL, from);
+                executor->poll_state[from] = POLL_CLOSED;
+                continue;
+            }
+            int is_buffered = 0;
+            for (int j = 0; j < buffered_n; ++j) is_buffered |= ready[j] == from;
+            if (!is_buffered) ready[ready_n++] = from;
+        }
+    } while (ready_n == 0);
+    return ready_n;
+}
+
+int wait_pipe_ready(void *self, local_id from, int timeout) {
+    executor     *executor = self;
+    PipeState    *state = executor->transport_state;
+    struct pollfd pfd = {.fd = executor->ch_read[from], .events = POLLIN};
+    int           rc = 0;
+    if (state->backlog[from].head != NULL) return 1;
+    if (get_buffered_frame_size(get_channel_buffer(executor, from)) > 0) return 1;
+    if (executor->poll_state[from] == POLL_CLOSED) return -1;
+    while ((rc = poll(&pfd, 1, timeout)) < 0 && errno == EINTR) {}
+    if (rc <= 0) return rc;
+    return pfd.revents & POLLIN ? 1 : -1;
+}
+
+void mask_pipe_poll(void *self, local_id from) {
+    executor *executor = self;
+    if (executor->poll_state[from] != POLL_ACTIVE) return;
+    if (ctl_channel_poll(executor, EPOLL_CTL_DEL, from) != 0) return;
+    executor->poll_state[from] = POLL_MASKED;
+}
+
+void unmask_pipes_poll(void *self) {
+    executor *executor = self;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (executor->poll_state[from] != POLL_MASKED) continue;
+        if (ctl_channel_poll(executor, EPOLL_CTL_ADD, from) != 0) continue;
+        executor->poll_state[from] = POLL_ACTIVE;
+    }
+}
+
 channel_h get_channel_read_h(void *self, local_id from) {
     executor *executor = self;
     return executor->ch_read[from];
@@ -140,3 +562,118 @@ channel_h get_channel_write_h(void *self, local_id dst) {
     executor *executor = self;
     return executor->ch_write[dst];
 }
+
+/**
+ * @brief      Gets the size of the first complete frame in the channel buffer, pipe is read if
+ * buffer has no complete frame.
+ *
+ * @return     Frame size, 0 if there is no complete frame
+ */
+uint32_t fill_channel_frame(executor *executor, local_id from) {
+    ChannelBuffer *buffer = get_channel_buffer(executor, from);
+    uint32_t       frame_size = get_buffered_frame_size(buffer);
+    if (frame_size == 0 && fill_channel_buffer(executor, from) <= 0) return 0;
+    if (frame_size == 0) frame_size = get_buffered_frame_size(buffer);
+    return frame_size;
+}
+
+/**
+ * @brief      Removes the first frame from the channel buffer.
+ */
+void drop_channel_frame(ChannelBuffer *buffer, uint32_t frame_size) {
+    buffer->start += frame_size;
+    if (buffer->start == buffer->end) buffer->start = buffer->end = 0;
+}
+
+int drain_channel(void *self, local_id from) {
+    executor      *executor = self;
+    PipeState     *state = executor->transport_state;
+    ChannelBuffer *buffer = get_channel_buffer(executor, from);
+    if (from == state->borrowed_from) return 0;
+    while (1) {
+        uint32_t frame_size = 0;
+        while ((frame_size = get_buffered_frame_size(buffer)) > 0) {
+            // frame stays in the buffer if there is no memory for its copy
+            if (push_pending(&state->backlog[from], buffer->data + buffer->start, frame_size)) {
+                return 0;
+            }
+            drop_channel_frame(buffer, frame_size);
+        }
+        ssize_t bytes = fill_channel_buffer(executor, from);
+        if (bytes == 0) return -1;
+        if (bytes < 0) return errno == EAGAIN ? 0 : -1;
+    }
+}
+
+int read_channel(void *self, local_id from, Message *msg) {
+    executor      *executor = self;
+    PipeState     *state = executor->transport_state;
+    PendingFrame  *frame = state->backlog[from].head;
+    ChannelBuffer *buffer = get_channel_buffer(executor, from);
+    if (frame != NULL) {
+        memcpy(msg, frame->data, frame->size);
+        pop_pending(&state->backlog[from]);
+        return 0;
+    }
+    uint32_t frame_size = fill_channel_frame(executor, from);
+    if (frame_size == 0) return -1;
+    memcpy(msg, buffer->data + buffer->start, frame_size);
+    drop_channel_frame(buffer, frame_size);
+    return 0;
+}
+
+int is_message_aligned(const void *data) {
+    return (uintptr_t)data % __alignof__(Message) == 0;
+}
+
+const Message *borrow_channel(void *self, local_id from) {
+    executor      *executor = self;
+    PipeState     *state = executor->transport_state;
+    PendingFrame  *item = state->backlog[from].head;
+    ChannelBuffer *buffer = get_channel_buffer(executor, from);
+    const char    *frame = NULL;
+    uint32_t       frame_size = 0;
+    if (item != NULL) {
+        frame = item->data;
+        frame_size = item->size;
+    } else {
+        frame_size = fill_channel_frame(executor, from);
+        if (frame_size == 0) return NULL;
+        frame = buffer->data + buffer->start;
+        state->borrowed_from = from;
+    }
+    if (is_message_aligned(frame)) return (const Message *)frame;
+    memcpy(executor->borrowed, frame, frame_size);
+    return executor->borrowed;
+}
+
+void release_channel(void *self, local_id from) {
+    executor      *executor = self;
+    PipeState     *state = executor->transport_state;
+    ChannelBuffer *buffer = get_channel_buffer(executor, from);
+    // pipe of the frame borrowed in place is not drained, so backlog stays empty until release
+    if (state->backlog[from].head != NULL) {
+        pop_pending(&state->backlog[from]);
+        return;
+    }
+    drop_channel_frame(buffer, get_buffered_frame_size(buffer));
+    state->borrowed_from = -1;
+}
+
+const transport pipe_transport = {
+    .name = "pipe",
+    .open = open_channels,
+    .set_executor = set_executor_channels,
+    .close_unused = close_unused_channels,
+    .close = close_channels,
+    .cleanup = cleanup_executor_channels,
+    .flush = flush_channels,
+    .write = write_channel,
+    .read = read_channel,
+    .borrow = borrow_channel,
+    .release = release_channel,
+    .wait_ready = wait_pipes_ready,
+    .wait_one_ready = wait_pipe_ready,
+    .mask = mask_pipe_poll,
+    .unmask = unmask_pipes_poll,
+};
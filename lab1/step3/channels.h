@@ -21,7 +21,81 @@ typedef struct {
     channel_h write_h;         ///< write handler for pipe
 } channel;
 
-#define SLEEP_RECEIVE_USEC 50  // usec between receive any msg
+#define CHANNEL_BUFFER_SIZE  16384  // bytes buffered from one reading pipe (>= MAX_MESSAGE_LEN)
+#define OUTBOUND_BUFFER_SIZE 8192   // bytes buffered for one writing pipe (>= MAX_MESSAGE_LEN)
+#define OUTBOUND_FLUSH_SIZE  4096   // buffered bytes which are flushed without waiting
+#define PENDING_HIGH_WATER   65536  // pending bytes for one pipe when sender waits for the reader
+#define POLL_BLOCK           -1     // wait for ready channels without timeout
+#define POLL_NOWAIT          0      // only check ready channels and return immediately
+
+#define POLL_BROKER_TAG 0x20000  // epoll data tag of lazy channels broker socket (see lazy.h)
+
+/**
+ * Bytes read from a pipe, but not decoded into messages yet. Bytes in [start, end) are a sequence
+ * of message frames (header + payload), the last frame can be incomplete.
+ */
+typedef struct {
+    uint32_t start;                      ///< Position of the first not decoded byte
+    uint32_t end;                        ///< Position after the last read byte
+    char     data[CHANNEL_BUFFER_SIZE];  ///< Read bytes
+} ChannelBuffer;
+
+typedef struct PendingFrame {
+    struct PendingFrame *next;    ///< Next frame to write
+    uint32_t             size;    ///< Frame size
+    char                 data[];  ///< Frame bytes (header + payload)
+} PendingFrame;
+
+/**
+ * Messages which do not fit into the outbound buffer while the pipe is full. They are moved into
+ * the outbound buffer when the pipe becomes writable, so messages are never dropped.
+ */
+typedef struct {
+    PendingFrame *head;       ///< First frame to write
+    PendingFrame *tail;       ///< Last queued frame
+    uint32_t      n;          ///< Current queue depth (frames)
+    uint32_t      bytes;      ///< Current queue size (bytes)
+    uint32_t      max_n;      ///< Max queue depth since start
+    uint32_t      total_n;    ///< Number of frames passed through the queue since start
+    uint32_t      waits_n;    ///< Number of times sender waited on high water mark
+    uint8_t       is_polled;  ///< Write handler is registered in poll (waiting to be writable)
+} PendingQueue;
+
+/**
+ * Messages sent to a pipe, but not written yet. Flushed before waiting for messages or when
+ * OUTBOUND_FLUSH_SIZE is reached.
+ */
+typedef struct {
+    uint32_t     size;                        ///< Number of buffered bytes
+    char         data[OUTBOUND_BUFFER_SIZE];  ///< Buffered message frames
+    PendingQueue pending;                     ///< Frames which do not fit into the buffer
+} OutboundBuffer;
+
+/**
+ * Pipes backend executor state. Frames read while sender waits for a full pipe are moved from the
+ * channel buffer into backlog, they are received before the rest of the channel buffer.
+ */
+typedef struct {
+    ChannelBuffer  *in;             ///< Buffers for reading pipes (indexed by source local id)
+    OutboundBuffer *out;            ///< Buffers for writing pipes (indexed by destination local id)
+    PendingQueue   *backlog;        ///< Frames read while waiting (indexed by source local id)
+    local_id        borrowed_from;  ///< Source of the frame borrowed in place, -1 if none
+} PipeState;
+
+/**
+ * Transport callbacks used by wait_pending_writable
+ */
+typedef struct {
+    int (*flush)(void *executor, local_id dst);   ///< Write pending frames, 0 if all are written
+    void (*drop)(void *executor, local_id dst);   ///< Drop pending frames (reader is closed)
+    int (*drain)(void *executor, local_id from);  ///< Keep inbound messages, -1 if closed
+} PendingWaitOps;
+
+typedef enum {
+    POLL_ACTIVE,  ///< Channel read handler is registered in poll
+    POLL_MASKED,  ///< Channel read handler is temporary removed from poll
+    POLL_CLOSED,  ///< Channel write side is closed and all data is read
+} PollState;
 
 /**
  * @brief      Sleep us
@@ -39,6 +113,17 @@ void sleep_us(unsigned long microseconds);
  */
 int init_channel(channel *channel);
 
+/**
+ * @brief      Add or remove channel read handler from the executor poll.
+ *
+ * @param      executor  The executor
+ * @param[in]  op        The epoll operation (EPOLL_CTL_ADD or EPOLL_CTL_DEL)
+ * @param[in]  from      The from process local id
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int ctl_channel_poll(void *executor, int op, local_id from);
+
 /**
  * @brief      Opens a channel between processes.
  *
@@ -63,7 +148,16 @@ int open_channel(channel **channels, local_id from, local_id dst);
  *
  * @return     0 on success, any non-zero value on error
  */
-int open_channels(int8_t proc_n, channel **channels);
+int open_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sets the executor read and write pipe handlers (ch_read and ch_write arrays).
+ *
+ * @param[in]  proc_n    The proc n
+ * @param      executor  The executor
+ * @param      channels  The channels
+ */
+void set_executor_handlers(int16_t proc_n, void *executor, channel **channels);
 
 /**
  * @brief      Sets the executor channels.
@@ -72,7 +166,179 @@ int open_channels(int8_t proc_n, channel **channels);
  * @param      executor  The executor
  * @param      channels  The channels
  */
-void set_executor_channels(int8_t proc_n, void *executor, channel **channels);
+void set_executor_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Initializes the executor channels poll (epoll instance with all read handlers).
+ *
+ * @param      executor  The executor
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int init_channels_poll(void *executor);
+
+/**
+ * @brief      Closes the executor channels poll.
+ *
+ * @param      executor  The executor
+ */
+void close_channels_poll(void *executor);
+
+/**
+ * @brief      Closes the executor channels poll and frees executor handlers arrays.
+ *
+ * @param      executor  The executor
+ */
+void cleanup_executor_channels(void *executor);
+
+/**
+ * @brief      Wait until some pipes have data to read. See wait_channels_ready
+ */
+int wait_pipes_ready(void *executor, local_id *ready, int timeout);
+
+/**
+ * @brief      Wait until a pipe from specified process has data to read. See wait_channel_ready
+ */
+int wait_pipe_ready(void *executor, local_id from, int timeout);
+
+/**
+ * @brief      Remove a pipe from specified process from poll. See mask_channel_poll
+ */
+void mask_pipe_poll(void *executor, local_id from);
+
+/**
+ * @brief      Return all masked pipes back to poll. See unmask_channels_poll
+ */
+void unmask_pipes_poll(void *executor);
+
+/**
+ * @brief      Writes all buffered messages to pipes.
+ *
+ * @param      executor  The executor
+ *
+ * @return     0 on success, any non-zero value if some bytes are still buffered
+ */
+int flush_channels(void *executor);
+
+/**
+ * @brief      Adds a frame copy to the end of pending queue.
+ *
+ * @param      pending  The pending queue
+ * @param[in]  frame    The frame bytes (header + payload)
+ * @param[in]  size     The frame size
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int push_pending(PendingQueue *pending, const void *frame, uint32_t size);
+
+/**
+ * @brief      Removes the first frame from pending queue (if any).
+ *
+ * @param      pending  The pending queue
+ */
+void pop_pending(PendingQueue *pending);
+
+/**
+ * @brief      Wait until pending queue of dst is below the limit. Read handlers of the executor are
+ * polled too and inbound messages are kept by transport, so two senders waiting for each other
+ * still make progress.
+ *
+ * @param      executor       The executor
+ * @param[in]  dst            The destination process local id
+ * @param[in]  pending        The pending queue of dst
+ * @param[in]  pending_limit  The pending bytes limit (0 to wait until everything is written)
+ * @param[in]  ops            The transport callbacks
+ */
+void wait_pending_writable(
+    void *executor, local_id dst, const PendingQueue *pending, uint32_t pending_limit,
+    const PendingWaitOps *ops
+);
+
+/**
+ * @brief      Initializes pipes backend state.
+ *
+ * @param      state   The state
+ * @param[in]  proc_n  The number of processes
+ */
+void init_pipe_state(PipeState *state, int16_t proc_n);
+
+/**
+ * @brief      Writes a message to the pipe self -> dst. Message is buffered and written together
+ * with other messages to the same pipe on flush. If the pipe is full, message is kept in the
+ * pending queue and written when the pipe becomes writable. Sender waits for the reader when
+ * pending queue reaches PENDING_HIGH_WATER (see wait_pending_writable).
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int write_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Reads a message from the pipe from -> self. All available bytes are read from the
+ * pipe into the channel buffer with one call, next messages are decoded from the buffer without
+ * system calls. Incomplete frame is kept in the buffer until the rest of it is read. Frames moved
+ * into backlog by drain_channel are read first.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no message or on error
+ */
+int read_channel(void *executor, local_id from, Message *msg);
+
+/**
+ * @brief      Reads all available bytes of the pipe from -> self and moves complete frames into
+ * backlog, so the writer of the pipe is not blocked. Pipe of the frame borrowed in place is not
+ * read.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ *
+ * @return     0 on success, -1 if the pipe is closed
+ */
+int drain_channel(void *executor, local_id from);
+
+/**
+ * @brief      Determines if channel buffer contains a complete message frame.
+ *
+ * @param      buffer  The channel buffer
+ *
+ * @return     Frame size if buffer has a complete frame, 0 otherwise.
+ */
+uint32_t get_buffered_frame_size(ChannelBuffer *buffer);
+
+/**
+ * @brief      Determines if message can be read in place at the address (alignment of Message
+ * type).
+ *
+ * @param[in]  data  The message bytes
+ *
+ * @return     1 if message is aligned, 0 otherwise
+ */
+int is_message_aligned(const void *data);
+
+/**
+ * @brief      Borrows the next message decoded from the pipe from -> self channel buffer. Message
+ * is copied into the executor borrow buffer only if frame is not aligned.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ *
+ * @return     The message, NULL if there is no complete message
+ */
+const Message *borrow_channel(void *executor, local_id from);
+
+/**
+ * @brief      Removes the borrowed message frame from the channel buffer.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ */
+void release_channel(void *executor, local_id from);
 
 /**
  * @brief      Closes unused channels.
@@ -83,7 +349,7 @@ void set_executor_channels(int8_t proc_n, void *executor, channel **channels);
  *
  * @return     0 on success, any non-zero value on error
  */
-int close_unused_channels(int8_t proc_n, local_id local_id, channel **channels);
+int close_unused_channels(int16_t proc_n, local_id local_id, channel **channels);
 
 /**
  * @brief      Gets the channel read pipe handler by process local id.
@@ -105,6 +371,13 @@ channel_h get_channel_read_h(void *self, local_id from);
  */
 channel_h get_channel_write_h(void *self, local_id dst);
 
+/**
+ * @brief      Closes a channel handler (if it is not closed yet) and marks it as closed (-1).
+ *
+ * @param      channel_h  The channel handler pointer
+ */
+void close_channel_handler(channel_h *channel_h);
+
 /**
  * @brief      Closes a channel from -> dst.
  *
@@ -125,6 +398,6 @@ int close_channel(channel **channels, local_id from, local_id dst);
  *
  * @return     0 on success, any non-zero value on error
  */
-int close_channels(int8_t proc_n, channel **channels);
+int close_channels(int16_t proc_n, channel **channels);
 
 #endif  // __ITMO_DISTRIBUTED_CLASS_CHANNELS__H
@@ -6,15 +6,17 @@
 #include <string.h>
 #include <unistd.h>
 
+#include "bitset.h"
 #include "channels.h"
+#include "control.h"
 #include "debug.h"
 #include "ipc.h"
 #include "ipc_util.h"
 #include "logger.h"
+#include "msgpool.h"
 #include "pa2345.h"
 #include "time.h"
-
-int usleep(__useconds_t useconds);
+#include "transport.h"
 
 int construct_msg_text(Message *msg, MessageType type, const char *msg_fmt, ...) {
     va_list args;
@@ -51,79 +53,106 @@ int tick_send_multicast(executor *self, Message *msg) {
     return send_multicast(self, msg);
 }
 
+Message *new_msg(executor *self, uint16_t payload_len) {
+    return alloc_msg(&self->msg_pool, payload_len);
+}
+
+/**
+ * @brief      Send a pool message and release it.
+ *
+ * @param      self  The executor process
+ * @param[in]  dst   The destination process local id (-1 for multicast)
+ * @param      msg   The pool message (NULL if it is not allocated)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int send_built_msg(executor *self, int dst, Message *msg) {
+    if (msg == NULL) return 1;
+    int rc = dst < 0 ? tick_send_multicast(self, msg) : tick_send(self, dst, msg);
+    release_msg(msg);
+    return rc;
+}
+
 int send_started_msg_multicast(executor *self) {
-    Message msg;
-    construct_msg_text(
-        &msg, STARTED, log_started_fmt, get_lamport_time(), self->local_id, self->pid,
-        self->parent_pid
-    );
-    return tick_send_multicast(self, &msg);
+    Message       *msg = new_msg(self, get_started_payload_len());
+    ControlMessage ctl = {.pid = self->pid, .parent_pid = self->parent_pid};
+    if (msg != NULL) encode_started_msg(msg, &ctl);
+    return send_built_msg(self, -1, msg);
 }
 
 int send_done_msg_multicast(executor *self) {
-    Message msg;
-    construct_msg_text(
-        &msg, DONE, log_done_fmt, get_lamport_time(), self->local_id, self->pid, self->parent_pid
-    );
-    return tick_send_multicast(self, &msg);
+    Message       *msg = new_msg(self, get_done_payload_len());
+    ControlMessage ctl = {.pid = self->pid, .parent_pid = self->parent_pid};
+    if (msg != NULL) encode_done_msg(msg, &ctl);
+    return send_built_msg(self, -1, msg);
 }
 
 int send_request_cs_msg_multicast(executor *self) {
-    Message msg;
-    construct_msg(&msg, CS_REQUEST, 0);
-    return tick_send_multicast(self, &msg);
+    Message *msg = new_msg(self, get_cs_request_payload_len());
+    if (msg != NULL) encode_cs_request_msg(msg, NULL);
+    return send_built_msg(self, -1, msg);
 }
 
 int send_reply_cs_msg(executor *self, local_id to) {
-    Message msg;
-    construct_msg(&msg, CS_REPLY, 0);
-    return tick_send(self, to, &msg);
+    Message *msg = new_msg(self, get_cs_reply_payload_len());
+    if (msg != NULL) encode_cs_reply_msg(msg, NULL);
+    return send_built_msg(self, to, msg);
 }
 
 int send_release_cs_msg_multicast(executor *self) {
-    Message msg;
-    construct_msg(&msg, CS_RELEASE, 0);
-    return tick_send_multicast(self, &msg);
+    Message *msg = new_msg(self, get_cs_release_payload_len());
+    if (msg != NULL) encode_cs_release_msg(msg, NULL);
+    return send_built_msg(self, -1, msg);
 }
 
-int is_received_msg_from(executor *self, uint8_t *received, local_id from) {
-    return received[from];
+int is_received_msg_from(executor *self, bitset_word *received, local_id from) {
+    return is_bit_set(received, from);
 }
 
-int is_received_all_child(executor *self, uint8_t *received) {
-    for (int other_id = 0; other_id < self->proc_n; ++other_id) {
-        if (other_id == self->local_id) continue;
-        if (other_id == PARENT_ID) continue;
-        if (!is_received_msg_from(self, received, other_id)) return 0;
-    }
-    return 1;
+int is_received_all_child(executor *self, bitset_word *received) {
+    // parent and self marks are not counted
+    int is_self_child = self->local_id != PARENT_ID;
+    int received_n = count_bits(received, self->proc_n) - is_bit_set(received, PARENT_ID)
+                     - (is_self_child && is_bit_set(received, self->local_id));
+    return received_n == self->proc_n - 1 - is_self_child;
 }
 
-void mark_received(uint8_t *received, local_id from) {
-    received[from] = 1;
+void mark_received(bitset_word *received, local_id from) {
+    set_bit(received, from);
 }
 
 int wait_receive_all_child_if(
-    executor *self, on_message_condition_t condition, void *condition_param, uint8_t *received,
-    on_message_t on_message
+    executor *self, on_message_condition_t condition, void *condition_param,
+    bitset_word *received, on_message_t on_message
 ) {
-    uint8_t  s_received[MAX_PROCESS_ID + 1] = {0};
-    uint8_t *l_received = received == NULL ? s_received : received;
-    Message  msg;
-    local_id from = 0;
-    while (!is_received_all_child(self, l_received)) {
-        if (from == self->proc_n - 1) usleep(SLEEP_RECEIVE_USEC);
-        from = (from + 1) % self->proc_n;
-        if (self->local_id == from) continue;
-        if (is_received_msg_from(self, l_received, from)) continue;
-        if (receive(self, from, &msg) != 0) continue;
-        if (condition(self, &msg, from, condition_param)) mark_received(l_received, from);
-        if (on_message != NULL) on_message(self, &msg, from);
+    bitset_word  s_received[BITSET_MAX_WORDS] = {0};
+    bitset_word *l_received = received == NULL ? s_received : received;
+    local_id     ready[MAX_PROCESS_ID + 1];
+    int          rc = 0;
+    // do not wake up on messages from processes we are not waiting for anymore
+    for (local_id from = 0; from < self->proc_n; ++from) {
+        if (is_received_msg_from(self, l_received, from)) mask_channel_poll(self, from);
     }
-    return 0;
+    while (rc == 0 && !is_received_all_child(self, l_received)) {
+        int ready_n = wait_channels_ready(self, ready, POLL_BLOCK);
+        if (ready_n < 0) rc = 1;
+        for (int i = 0; i < ready_n; ++i) {
+            local_id       from = ready[i];
+            const Message *msg = receive_borrow(self, from);
+            if (msg == NULL) continue;
+            if (condition(self, msg, from, condition_param)) {
+                mark_received(l_received, from);
+                mask_channel_poll(self, from);
+            }
+            if (on_message != NULL) on_message(self, msg, from);
+            receive_release(self, from);
+        }
+    }
+    unmask_channels_poll(self);
+    return rc;
 }
 
-int condifion_msg_type(executor *self, Message *msg, local_id from, void *condition_param) {
+int condifion_msg_type(executor *self, const Message *msg, local_id from, void *condition_param) {
     MessageType *type = condition_param;
     return msg->s_header.s_type == *type;
 }
@@ -133,47 +162,69 @@ int wait_receive_all_child_msg_by_type(executor *self, MessageType type, on_mess
     return wait_receive_all_child_if(self, condifion_msg_type, &s_type, NULL, on_message);
 }
 
-int condifion_msg_after(executor *self, Message *msg, local_id from, void *condition_param) {
+int condifion_msg_after(executor *self, const Message *msg, local_id from, void *condition_param) {
     timestamp_t *after = condition_param;
     return msg->s_header.s_local_time > *after;
 }
 
 int wait_receive_all_child_msg_after(executor *self, timestamp_t after, on_message_t on_message) {
     timestamp_t s_after = after;
-    uint8_t     received[MAX_PROCESS_ID + 1] = {0};
+    bitset_word received[BITSET_MAX_WORDS] = {0};
     for (local_id s_id = 0; s_id < self->proc_n; ++s_id) {
         if (self->last_recv_at[s_id] > s_after) mark_received(received, s_id);
     }
     return wait_receive_all_child_if(self, condifion_msg_after, &s_after, received, on_message);
 }
 
-int receive_any_cb(executor *self, on_message_t on_message) {
-    Message msg;
-    int     received = 0;
-    for (local_id from = 0; from < self->proc_n; ++from) {
-        if (self->local_id == from) continue;
-        if (receive(self, from, &msg) == 0) {
-            if (on_message != NULL) on_message(self, &msg, from);
-            received++;
-        }
+/**
+ * @brief      Receive messages from all ready channels and run callback
+ *
+ * @param      self        The executor process
+ * @param[in]  on_message  On message callback
+ * @param[in]  timeout     The timeout in milliseconds (POLL_BLOCK or POLL_NOWAIT are possible)
+ *
+ * @return     0 if any message is received, 1 if there is no messages, -1 on error
+ */
+int receive_ready_cb(executor *self, on_message_t on_message, int timeout) {
+    local_id ready[MAX_PROCESS_ID + 1];
+    int      received = 0;
+    int      ready_n = wait_channels_ready(self, ready, timeout);
+    if (ready_n < 0) return -1;
+    for (int i = 0; i < ready_n; ++i) {
+        const Message *msg = receive_borrow(self, ready[i]);
+        if (msg == NULL) continue;
+        if (on_message != NULL) on_message(self, msg, ready[i]);
+        receive_release(self, ready[i]);
+        received++;
     }
     return received > 0 ? 0 : 1;
 }
 
+int receive_any_cb(executor *self, on_message_t on_message) {
+    return receive_ready_cb(self, on_message, POLL_NOWAIT);
+}
+
+int wait_receive_any_cb(executor *self, on_message_t on_message) {
+    int rc = 0;
+    while ((rc = receive_ready_cb(self, on_message, POLL_BLOCK)) > 0) {}
+    return rc;
+}
+
 void hanle_pending(executor *self, on_message_t on_message) {
     while (receive_any_cb(self, on_message) == 0) {}
 }
 
 int wait_receive_msg_by_type(executor *self, MessageType type, local_id from) {
-    Message  msg;
     uint16_t received = 0;
     debug_ipc_print(
         debug_ipc_wait_msg_fmt, get_lamport_time(), self->local_id, get_msg_type_text(type), from
     );
     while (!received) {
-        int rc = receive(self, from, &msg);
-        if (rc == 0 && msg.s_header.s_type == type) received = 1;
-        if (rc != 0) usleep(SLEEP_RECEIVE_USEC);
+        if (wait_channel_ready(self, from, POLL_BLOCK) < 0) return 1;
+        const Message *msg = receive_borrow(self, from);
+        if (msg == NULL) continue;
+        received = msg->s_header.s_type == type;
+        receive_release(self, from);
     }
     debug_ipc_print(
         debug_ipc_await_msg_fmt, get_lamport_time(), self->local_id, get_msg_type_text(type), from
@@ -181,7 +232,7 @@ int wait_receive_msg_by_type(executor *self, MessageType type, local_id from) {
     return 0;
 }
 
-void deserialize_struct(Message *msg, void *target, size_t t_size) {
+void deserialize_struct(const Message *msg, void *target, size_t t_size) {
     memcpy(target, msg->s_payload, t_size);
 }
 
@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 
+#include "bitset.h"
 #include "channels.h"
 #include "executor.h"
 #include "ipc.h"
@@ -36,6 +37,17 @@ int construct_msg_text(Message *msg, MessageType type, const char *msg_fmt, ...)
  */
 int construct_msg(Message *msg, MessageType type, uint16_t buffer_len);
 
+/**
+ * @brief      Allocates a message with room for exactly header and payload from the executor pool.
+ * Message is built in place, sent (multicast message is shared by all destinations) and released.
+ *
+ * @param      self         The executor process
+ * @param[in]  payload_len  The payload length
+ *
+ * @return     The message, NULL on error
+ */
+Message *new_msg(executor *self, uint16_t payload_len);
+
 /**
  * @brief      Sends a started message multicast.
  *
@@ -91,7 +103,7 @@ int send_release_cs_msg_multicast(executor *self);
  *
  * @return     1 if received message from, 0 otherwise.
  */
-int is_received_msg_from(executor *self, uint8_t *received, local_id from);
+int is_received_msg_from(executor *self, bitset_word *received, local_id from);
 
 /**
  * @brief      Determines if received from all children.
@@ -101,7 +113,7 @@ int is_received_msg_from(executor *self, uint8_t *received, local_id from);
  *
  * @return     1 if received from all children, 0 otherwise.
  */
-int is_received_all_child(executor *self, uint8_t *received);
+int is_received_all_child(executor *self, bitset_word *received);
 
 /**
  * @brief      Mark mask bit connected with local_id process as received.
@@ -109,7 +121,7 @@ int is_received_all_child(executor *self, uint8_t *received);
  * @param      received  The received mask
  * @param[in]  from  The from process local id
  */
-void mark_received(uint8_t *received, local_id from);
+void mark_received(bitset_word *received, local_id from);
 
 /**
  * Callback type for message handling
@@ -118,7 +130,7 @@ void mark_received(uint8_t *received, local_id from);
  * @param       msg         The message pointer
  * @param       local_id    Local process id mesage received from
  */
-typedef void (*on_message_t)(executor *, Message *, local_id);
+typedef void (*on_message_t)(executor *, const Message *, local_id);
 
 /**
  * Callback type for message handling
@@ -130,7 +142,7 @@ typedef void (*on_message_t)(executor *, Message *, local_id);
  *
  * @return     True for success condition, False otherwise
  */
-typedef int (*on_message_condition_t)(executor *, Message *, local_id, void *);
+typedef int (*on_message_condition_t)(executor *, const Message *, local_id, void *);
 
 /**
  * @brief      Wait for all messages received from children when condition is True for message (from
@@ -138,7 +150,7 @@ typedef int (*on_message_condition_t)(executor *, Message *, local_id, void *);
  *
  * @param      self             The object
  * @param[in]  condition        The condition
- * @param      received  Pointer to recieved array (nullable). Can be useful to mark recieved before
+ * @param      received  Pointer to recieved set (nullable). Can be useful to mark recieved before
  * recieve any message
  * @param      condition_param  The condition parameter (any pointer)
  * @param[in]  on_message       On message callback (will be called on each message, nullable)
@@ -146,8 +158,8 @@ typedef int (*on_message_condition_t)(executor *, Message *, local_id, void *);
  * @return     0 on success, any non-zero value on error
  */
 int wait_receive_all_child_if(
-    executor *self, on_message_condition_t condition, void *condition_param, uint8_t *received,
-    on_message_t on_message
+    executor *self, on_message_condition_t condition, void *condition_param,
+    bitset_word *received, on_message_t on_message
 );
 
 /**
@@ -193,6 +205,16 @@ int wait_receive_msg_by_type(executor *self, MessageType type, local_id from);
  */
 int receive_any_cb(executor *self, on_message_t on_message);
 
+/**
+ * @brief      Wait until any message is received and run callback for all ready messages
+ *
+ * @param      self        The executor process
+ * @param[in]  on_message  On message callback
+ *
+ * @return     0 on success, any non-zero value on error (e.g. all channels are closed)
+ */
+int wait_receive_any_cb(executor *self, on_message_t on_message);
+
 /**
  * @brief      Handle pending messages
  *
@@ -231,7 +253,7 @@ int tick_send_multicast(executor *self, Message *msg);
  * @param[in]  t_size  The size of target struct type, usually sizeof(<type>), where <type> is type
  * of target
  */
-void deserialize_struct(Message *msg, void *target, size_t t_size);
+void deserialize_struct(const Message *msg, void *target, size_t t_size);
 
 /**
  * @brief      Serialize target struct into message payload buffer
@@ -0,0 +1,51 @@
+#include "control.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "debug.h"
+#include "ipc.h"
+
+#define CONTROL_ENCODE_FIELD(field)                                  \
+    memcpy(msg->s_payload + len, &ctl->field, sizeof(ctl->field)); \
+    len += sizeof(ctl->field);
+
+#define CONTROL_DECODE_FIELD(field)                                       \
+    if (len + sizeof(ctl->field) > msg->s_header.s_payload_len) return 1; \
+    memcpy(&ctl->field, msg->s_payload + len, sizeof(ctl->field));        \
+    len += sizeof(ctl->field);
+
+#define CONTROL_FIELD_SIZE(field) +sizeof(((ControlMessage *)NULL)->field)
+
+#define CONTROL_CODEC_DEFINE(type, name, FIELDS)                       \
+    int encode_##name##_msg(Message *msg, const ControlMessage *ctl) { \
+        uint16_t len = 0;                                              \
+        FIELDS(CONTROL_ENCODE_FIELD)                                   \
+        msg->s_header.s_magic = MESSAGE_MAGIC;                         \
+        msg->s_header.s_type = type;                                   \
+        msg->s_header.s_payload_len = len;                             \
+        return 0;                                                      \
+    }                                                                  \
+    int decode_##name##_msg(const Message *msg, ControlMessage *ctl) { \
+        uint16_t len = 0;                                              \
+        if (msg->s_header.s_type != type) return 1;                    \
+        FIELDS(CONTROL_DECODE_FIELD)                                   \
+        return len == msg->s_header.s_payload_len ? 0 : 1;             \
+    }                                                                  \
+    uint16_t get_##name##_payload_len() {                              \
+        return 0 FIELDS(CONTROL_FIELD_SIZE);                           \
+    }
+
+CONTROL_MESSAGES(CONTROL_CODEC_DEFINE)
+
+void debug_control_print(const Message *msg, local_id from) {
+    ControlMessage ctl;
+    if (!get_debug_ipc()) return;
+    timestamp_t time = msg->s_header.s_local_time;
+    if (decode_started_msg(msg, &ctl) == 0) {
+        debug_ipc_print(debug_ipc_started_fmt, time, from, ctl.pid, ctl.parent_pid);
+    } else if (decode_done_msg(msg, &ctl) == 0) {
+        debug_ipc_print(debug_ipc_done_fmt, time, from);
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file     control.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Binary schema of control messages (STARTED, DONE, ACK, STOP, CS_*) with encoder and
+ * decoder generated for every message type
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_CONTROL__H
+#define __ITMO_DISTRIBUTED_CLASS_CONTROL__H
+
+#include <stdint.h>
+
+#include "ipc.h"
+
+/**
+ * Control message fields. Type specific subset of fields is written to payload one after another
+ * without padding (sender id and time are in the message header already).
+ */
+typedef struct {
+    int32_t pid;         ///< Sender process id
+    int32_t parent_pid;  ///< Sender parent process id
+} ControlMessage;
+
+#define CONTROL_PROCESS_FIELDS(F) F(pid) F(parent_pid)
+#define CONTROL_NO_FIELDS(F)
+
+/**
+ * Control messages schema: X(message type, codec name, fields list)
+ */
+#define CONTROL_MESSAGES(X)                      \
+    X(STARTED, started, CONTROL_PROCESS_FIELDS)  \
+    X(DONE, done, CONTROL_PROCESS_FIELDS)        \
+    X(ACK, ack, CONTROL_NO_FIELDS)               \
+    X(STOP, stop, CONTROL_NO_FIELDS)             \
+    X(CS_REQUEST, cs_request, CONTROL_NO_FIELDS) \
+    X(CS_REPLY, cs_reply, CONTROL_NO_FIELDS)     \
+    X(CS_RELEASE, cs_release, CONTROL_NO_FIELDS)
+
+/**
+ * Encoder and decoder of every control message type, e.g. for STARTED:
+ *
+ * int encode_started_msg(Message *msg, const ControlMessage *ctl) - writes header (except time)
+ * and type fields of ctl to payload (ctl can be NULL for types without fields). Returns 0 on
+ * success.
+ *
+ * int decode_started_msg(const Message *msg, ControlMessage *ctl) - reads type fields from
+ * payload. Returns 0 on success, any non-zero value if message has other type or size.
+ *
+ * uint16_t get_started_payload_len() - payload length of encoded message.
+ */
+#define CONTROL_CODEC_DECLARE(type, name, FIELDS)                     \
+    int encode_##name##_msg(Message *msg, const ControlMessage *ctl); \
+    int decode_##name##_msg(const Message *msg, ControlMessage *ctl); \
+    uint16_t get_##name##_payload_len();
+
+CONTROL_MESSAGES(CONTROL_CODEC_DECLARE)
+
+/**
+ * @brief      Render received control message as text with debug IPC print (nothing is
+ * formatted when debug IPC is disabled).
+ *
+ * @param[in]  msg   The message
+ * @param[in]  from  The sender process local id
+ */
+void debug_control_print(const Message *msg, local_id from);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_CONTROL__H
@@ -0,0 +1,98 @@
+// ucontext is not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "coroutine.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <ucontext.h>
+
+#include "channels.h"
+#include "executor.h"
+#include "ipc.h"
+#include "time.h"
+#include "wait.h"
+#include "worker.h"
+
+static ucontext_t scheduler_context;  // context of run_coroutines loop
+static Coroutine *coroutines = NULL;
+static int        current = -1;  // index of running coroutine (-1 for scheduler)
+static int        live_n = 0;    // number of coroutines with not finished workers
+
+/**
+ * @brief      Coroutine entry point (makecontext passes only int arguments).
+ */
+void run_coroutine(int index) {
+    run_worker(coroutines[index].executor);
+    coroutines[index].is_done = 1;
+    live_n--;
+    // returns to scheduler with uc_link
+}
+
+int run_coroutines(int proc_n, executor *executors) {
+    int rc = 0;
+    int done_n = 0;
+    coroutines = calloc(proc_n, sizeof(Coroutine));
+    if (coroutines == NULL) return 1;
+    live_n = proc_n;
+    for (int i = 0; i < proc_n && rc == 0; ++i) {
+        Coroutine *coroutine = &coroutines[i];
+        coroutine->executor = &executors[i];
+        coroutine->local_time = get_lamport_time();
+        coroutine->stack = malloc(COROUTINE_STACK_SIZE);
+        if (coroutine->stack == NULL || getcontext(&coroutine->context) != 0) {
+            rc = 1;
+            break;
+        }
+        coroutine->context.uc_stack.ss_sp = coroutine->stack;
+        coroutine->context.uc_stack.ss_size = COROUTINE_STACK_SIZE;
+        coroutine->context.uc_link = &scheduler_context;
+        makecontext(&coroutine->context, (void (*)())run_coroutine, 1, i);
+    }
+    while (rc == 0 && done_n < proc_n) {
+        done_n = 0;
+        for (current = 0; current < proc_n; ++current) {
+            Coroutine *coroutine = &coroutines[current];
+            if (coroutine->is_done) {
+                done_n++;
+                continue;
+            }
+            // every executor has own clock, but all of them run in this thread
+            set_lamport_time(coroutine->local_time);
+            if (swapcontext(&scheduler_context, &coroutine->context) != 0) rc = 1;
+            coroutine->local_time = get_lamport_time();
+        }
+        current = -1;
+    }
+    for (int i = 0; i < proc_n; ++i) free(coroutines[i].stack);
+    free(coroutines);
+    coroutines = NULL;
+    live_n = 0;
+    return rc;
+}
+
+void yield_coroutine() {
+    if (current < 0) return;
+    swapcontext(&coroutines[current].context, &scheduler_context);
+}
+
+int get_live_coroutines_n() {
+    return live_n;
+}
+
+int wait_yield(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    int rc = 0;
+    while (1) {
+        uint64_t start = get_wait_time_ns();
+        rc = probe(self, arg, POLL_NOWAIT);
+        uint64_t checked = get_wait_time_ns();
+        stats->spin_ns += checked - start;
+        if (rc != 0) return rc;
+        // time of other coroutines is counted as sleep of this one
+        yield_coroutine();
+        stats->sleep_ns += get_wait_time_ns() - checked;
+        stats->sleep_n++;
+    }
+}
+
+const wait_policy yield_wait_policy = {.name = "yield", .wait = wait_yield};
@@ -0,0 +1,60 @@
+/**
+ * @file     coroutine.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Coroutines scheduler: many executors run in one thread and switch on waits
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_COROUTINE__H
+#define __ITMO_DISTRIBUTED_CLASS_COROUTINE__H
+
+#include <stdint.h>
+#include <ucontext.h>
+
+#include "executor.h"
+#include "ipc.h"
+#include "wait.h"
+
+#define COROUTINE_STACK_SIZE (256 * 1024)  // bytes of one coroutine stack
+
+/**
+ * Executor running as coroutine
+ */
+typedef struct {
+    ucontext_t  context;     ///< Saved registers and stack of coroutine
+    void       *stack;       ///< Coroutine stack memory
+    executor   *executor;    ///< Executor run by coroutine
+    timestamp_t local_time;  ///< Executor Lamport time while coroutine is switched out
+    uint8_t     is_done;     ///< Executor worker is finished
+} Coroutine;
+
+/**
+ * Wait policy of executors running as coroutines: channels are checked without blocking and
+ * coroutine yields to the next one while there is nothing to receive
+ */
+extern const wait_policy yield_wait_policy;
+
+/**
+ * @brief      Runs workers of all executors as coroutines of the calling thread. Coroutines are
+ * switched round-robin, every coroutine runs until it waits for messages. Returns when all workers
+ * are finished.
+ *
+ * @param[in]  proc_n     The number of executors
+ * @param      executors  The executors array (initialized)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int run_coroutines(int proc_n, executor *executors);
+
+/**
+ * @brief      Switches from current coroutine to the scheduler (it resumes the next coroutine).
+ */
+void yield_coroutine();
+
+/**
+ * @brief      Gets the number of coroutines which workers are not finished yet.
+ *
+ * @return     The number of live coroutines (0 if coroutines are not running)
+ */
+int get_live_coroutines_n();
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_COROUTINE__H
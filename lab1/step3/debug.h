@@ -98,11 +98,35 @@ static const char* const debug_channel_open_fmt
     = "open_channel %2d -> %2d [rc=%d] [ %2d -> %2d ]\n";
 static const char* const debug_channel_open_start_fmt = "open_channels start. proc_n = %d\n";
 static const char* const debug_channel_set_fmt = "[local_id=%2d] ch set %c %d -> %d: %d\n";
+static const char* const debug_shm_open_fmt = "open_shm_channels proc_n = %d [size=%zu] [%p]\n";
+static const char* const debug_wait_stats_fmt
+    = "[local_id=%2d] wait policy %s [waits=%u] [spin=%.3f ms] [sleep=%.3f ms] [sleeps=%u]\n";
+static const char* const debug_lazy_channels_stats_fmt
+    = "[local_id=%2d] lazy channels [opened=%u] [accepted=%u]\n";
+static const char* const debug_tree_forward_fmt
+    = "[local_id=%2d] tree forward %2d -> %2d [origin=%d] [dst=%d]\n";
+static const char* const debug_tree_stats_fmt = "[local_id=%2d] tree [fanout=%d] [forwarded=%u]\n";
+static const char* const debug_msg_pool_stats_fmt
+    = "[local_id=%2d] message pool [messages=%u] [blocks=%u] [deferred=%u]\n";
+static const char* const debug_shm_doorbell_stats_fmt
+    = "[local_id=%2d] shm doorbell [sleeps=%u] [wakes=%u] [space_waits=%u]\n";
+static const char* const debug_channel_fill_fmt
+    = "[local_id=%2d] ch fill %2d -> self [bytes=%d] [buffered=%u]\n";
+static const char* const debug_channel_flush_fmt
+    = "[local_id=%2d] ch flush self -> %2d [bytes=%d] [buffered=%u]\n";
+static const char* const debug_channel_high_water_fmt
+    = "[local_id=%2d] ch self -> %2d reached high water mark [pending_bytes=%u]\n";
+static const char* const debug_channel_pending_stats_fmt
+    = "[local_id=%2d] ch self -> %2d pending [total=%u] [max=%u] [waits=%u]\n";
+static const char* const debug_channel_poll_fmt = "[local_id=%2d] ch poll %d -> self: %d\n";
+static const char* const debug_uring_open_fmt = "[local_id=%2d] io_uring ring_h=%d [read=%s]\n";
+static const char* const debug_uring_stats_fmt
+    = "[local_id=%2d] io_uring [enter=%u] [sqe=%u] [cqe=%u]\n";
 
 static const char* const debug_ipc_receive_fmt
     = "%2d: [local_id=%2d] recv %2d <- %2d <type=%15s> [msg_time=%2d] [prev_time=%2d] [bytes=%d]\n";
 static const char* const debug_ipc_send_fmt
-    = "%2d: [local_id=%2d] send %2d -> %2d <type=%15s> [msg_time=%2d] [bytes=%d] [channel_h=%d]\n";
+    = "%2d: [local_id=%2d] send %2d -> %2d <type=%15s> [msg_time=%2d] [bytes=%d] [transport=%s]\n";
 static const char* const debug_ipc_send_multicast_fmt
     = "%2d: [local_id=%2d] send %2d ->  * <type=%15s> [msg_time=%2d]\n";
 static const char* const debug_ipc_wait_msg_fmt
@@ -111,6 +135,9 @@ static const char* const debug_ipc_await_msg_fmt
     = "%2d: [local_id=%2d] Awaited message <type=%s> [from=%2d]\n";
 static const char* const debug_ipc_send_failed_fmt
     = "%2d: [local_id=%2d] send failed %2d -> %2d <type=%10s> [msg_time=%2d]\n";
+static const char* const debug_ipc_started_fmt
+    = "%d: process %1d (pid %5d, parent %5d) has STARTED\n";
+static const char* const debug_ipc_done_fmt = "%d: process %1d has DONE\n";
 
 static const char* const debug_log_open_file_fmt = "open %s [fd=%d]\n";
 static const char* const debug_log_msg_file_fmt = "log_file_msg [fd=%d] [bufsz=%lu]\n";
@@ -10,24 +10,41 @@
 #include <stdint.h>
 #include <unistd.h>
 
+#include "bitset.h"
 #include "channels.h"
 #include "ipc.h"
+#include "lane.h"
 #include "lock.h"
+#include "msgpool.h"
+#include "transport.h"
+#include "tree.h"
+#include "wait.h"
 
 typedef struct {
-    local_id    local_id;  ///< Local process id (usually index of created process)
-    channel_h  *ch_read;   ///< Array of reading pipe handlers
-    channel_h  *ch_write;  ///< Array of writing pipe handlers
-    uint8_t     proc_n;    ///< Number of processes
-    uint8_t     proc_done[MAX_PROCESS_ID + 1];  ///< Info which processes are done
-    uint8_t     is_self_done;                   ///< Info which processes are done
-    uint8_t     all_done;                       ///< Info which processes are done
-    uint8_t     use_lock;                       ///< Info which processes are done
-    pid_t       parent_pid;                     ///< Parend process id
-    pid_t       pid;                            ///< Executor process id
-    timestamp_t last_recv_at[MAX_PROCESS_ID + 1];
-    timestamp_t last_send_at[MAX_PROCESS_ID + 1];
-    Lock        lock;
+    local_id           local_id;         ///< Local process id (usually index of created process)
+    const transport   *transport;        ///< Transport backend used for communication
+    void              *transport_state;  ///< Transport backend specific executor state
+    const wait_policy *wait_policy;      ///< Policy of waiting for messages
+    WaitStats          wait_stats;       ///< Time spent waiting for messages
+    Message           *borrowed;         ///< Borrowed message which can not be read in place
+    MsgPool            msg_pool;         ///< Pool of messages built by executor
+    LaneState          lanes;            ///< Bulk messages waiting behind control messages
+    TreeState          tree;             ///< Messages delivered over tree of processes
+    channel_h         *ch_read;          ///< Array of reading pipe handlers
+    channel_h         *ch_write;         ///< Array of writing pipe handlers
+    channel_h          poll_h;           ///< Epoll handler for all reading pipe handlers
+    uint16_t           poll_n;           ///< Number of reading pipe handlers registered in poll
+    uint16_t           proc_n;           ///< Number of processes
+    uint8_t           *poll_state;       ///< Poll state (PollState) of each reading pipe handler
+    bitset_word       *proc_done;        ///< Set of processes which are done
+    uint8_t            is_self_done;     ///< Info which processes are done
+    uint8_t            all_done;         ///< Info which processes are done
+    uint8_t            use_lock;         ///< Info which processes are done
+    pid_t              parent_pid;       ///< Parend process id
+    pid_t              pid;              ///< Executor process id
+    timestamp_t       *last_recv_at;     ///< Time of the last message received from each process
+    timestamp_t       *last_send_at;     ///< Time of the last message sent to each process
+    Lock               lock;
 } executor;
 
 /**
@@ -37,6 +54,6 @@ typedef struct {
  * @param      msg   The message
  * @param[in]  from  The from process local id
  */
-void on_message(executor *self, Message *msg, local_id from);
+void on_message(executor *self, const Message *msg, local_id from);
 
 #endif  // __ITMO_DISTRIBUTED_CLASS_EXECUTOR__H
@@ -0,0 +1,350 @@
+// PIPE_BUF is not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "inbox.h"
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "transport.h"
+
+enum { MAX_INBOX_PAYLOAD_LEN = PIPE_BUF - sizeof(InboxFrameHeader) };
+
+int open_inbox_channels(int16_t proc_n, channel **channels) {
+    for (local_id dst = 0; dst < proc_n; ++dst) {
+        if (init_channel(&channels[dst][dst]) != 0) return 1;
+        log_pipes_msg(
+            log_inbox_channel_opened_fmt, dst, channels[dst][dst].write_h, channels[dst][dst].read_h
+        );
+    }
+    return 0;
+}
+
+void set_executor_inbox_channels(int16_t proc_n, void *self, channel **channels) {
+    executor *executor = self;
+    local_id  local_id = executor->local_id;
+
+    executor->ch_read = malloc(proc_n * sizeof(channel_h));
+    executor->ch_write = malloc(proc_n * sizeof(channel_h));
+    InboxState *state = calloc(1, sizeof(InboxState));
+    state->queues = calloc(proc_n, sizeof(InboxQueue));
+    state->pending = calloc(proc_n, sizeof(PendingQueue));
+    executor->transport_state = state;
+    executor->poll_h = -1;
+    executor->poll_n = 0;
+
+    for (int other_id = 0; other_id < proc_n; ++other_id) {
+        // all messages are read from the own inbox
+        executor->ch_read[other_id] = channels[local_id][local_id].read_h;
+        // write to the inbox of other process
+        executor->ch_write[other_id]
+            = other_id == local_id ? -1 : channels[other_id][other_id].write_h;
+        executor->poll_state[other_id] = other_id == local_id ? POLL_CLOSED : POLL_ACTIVE;
+        executor->poll_n += other_id != local_id;
+        debug_print(
+            debug_channel_set_fmt, local_id, 'w', local_id, other_id, executor->ch_write[other_id]
+        );
+    }
+    debug_print(debug_channel_set_fmt, local_id, 'r', local_id, local_id, executor->ch_read[0]);
+}
+
+int close_unused_inbox_channels(int16_t proc_n, local_id local_id, channel **channels) {
+    for (int other_id = 0; other_id < proc_n; ++other_id) {
+        // process reads only own inbox and never writes to it
+        if (other_id == local_id) close_channel_handler(&channels[other_id][other_id].write_h);
+        else close_channel_handler(&channels[other_id][other_id].read_h);
+    }
+    return 0;
+}
+
+int close_inbox_channels(int16_t proc_n, channel **channels) {
+    for (local_id dst = 0; dst < proc_n; ++dst) {
+        close_channel(channels, dst, dst);
+        log_pipes_msg(log_inbox_channel_closed_fmt, dst);
+    }
+    return 0;
+}
+
+/**
+ * @brief      Writes one frame to the inbox of dst without waiting.
+ *
+ * @return     0 if frame is written, 1 if the inbox is full, -1 on error
+ */
+int write_inbox_frame(executor *executor, local_id dst, const void *frame, uint32_t size) {
+    // writes up to PIPE_BUF bytes are atomic, so frame is written completely or not at all
+    ssize_t bytes = write(executor->ch_write[dst], frame, size);
+    if (bytes == (ssize_t)size) return 0;
+    if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 1;
+    return -1;
+}
+
+/**
+ * @brief      Write pending frames to the inbox of dst until it is full. Frames are dropped if they
+ * can not be delivered (e.g. the other process is finished).
+ *
+ * @return     0 if everything is written, 1 if some frames are still pending
+ */
+int flush_inbox_pending(void *self, local_id dst) {
+    executor     *executor = self;
+    InboxState   *state = executor->transport_state;
+    PendingQueue *pending = &state->pending[dst];
+    while (pending->head != NULL) {
+        int rc = write_inbox_frame(executor, dst, pending->head->data, pending->head->size);
+        if (rc > 0) break;
+        pop_pending(pending);
+    }
+    return pending->n > 0;
+}
+
+/**
+ * @brief      Drop pending frames for the inbox of dst (the other process is finished).
+ */
+void drop_inbox_pending(void *self, local_id dst) {
+    executor   *executor = self;
+    InboxState *state = executor->transport_state;
+    while (state->pending[dst].head != NULL) pop_pending(&state->pending[dst]);
+}
+
+/**
+ * @brief      Read one frame from the inbox pipe and put it to the sender queue.
+ *
+ * @param      self  The executor
+ *
+ * @return     0 on success, 1 if inbox is empty, -1 if all senders closed the inbox or on error
+ */
+int read_inbox_frame(executor *self) {
+    InboxState      *state = self->transport_state;
+    channel_h        inbox_h = self->ch_read[self->local_id];
+    InboxFrameHeader header;
+    ssize_t          bytes = read(inbox_h, &header, sizeof(InboxFrameHeader));
+    if (bytes == 0) return -1;
+    if (bytes < 0) return errno == EAGAIN ? 1 : -1;
+
+    size_t        msg_size = sizeof(MessageHeader) + header.s_header.s_payload_len;
+    InboxMessage *item = malloc(offsetof(InboxMessage, msg) + msg_size);
+    if (item == NULL) {
+        // skip payload, so the next frames are still read from their start
+        char payload[MAX_INBOX_PAYLOAD_LEN];
+        if (header.s_header.s_payload_len > 0) {
+            read(inbox_h, payload, header.s_header.s_payload_len);
+        }
+        return -1;
+    }
+    item->next = NULL;
+    item->msg.s_header = header.s_header;
+    if (header.s_header.s_payload_len > 0
+        && read(inbox_h, item->msg.s_payload, header.s_header.s_payload_len) <= 0) {
+        free(item);
+        return -1;
+    }
+
+    InboxQueue *queue = &state->queues[header.s_from];
+    if (queue->tail == NULL) queue->head = item;
+    else queue->tail->next = item;
+    queue->tail = item;
+    return 0;
+}
+
+/**
+ * @brief      Read all frames available in the inbox pipe.
+ *
+ * @param      self  The executor
+ *
+ * @return     0 on success, -1 if all senders closed the inbox or on error
+ */
+int drain_inbox(executor *self) {
+    int rc = 0;
+    while ((rc = read_inbox_frame(self)) == 0) {}
+    return rc < 0 ? -1 : 0;
+}
+
+/**
+ * @brief      Read all frames available in the inbox pipe (inbox is shared by all senders, so from
+ * is not used).
+ *
+ * @return     0 on success, -1 if all senders closed the inbox or on error
+ */
+int drain_inbox_channel(void *self, local_id from) {
+    return drain_inbox(self);
+}
+
+const PendingWaitOps inbox_wait_ops = {
+    .flush = flush_inbox_pending,
+    .drop = drop_inbox_pending,
+    .drain = drain_inbox_channel,
+};
+
+int flush_inbox_channels(void *self) {
+    executor   *executor = self;
+    InboxState *state = executor->transport_state;
+    int         rc = 0;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (state->pending[dst].n == 0) continue;
+        rc |= flush_inbox_pending(executor, dst);
+    }
+    return rc;
+}
+
+void cleanup_executor_inbox_channels(void *self) {
+    executor   *executor = self;
+    InboxState *state = executor->transport_state;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst == executor->local_id) continue;
+        PendingQueue *pending = &state->pending[dst];
+        // messages must be delivered before exit (unless the other process is finished)
+        wait_pending_writable(executor, dst, pending, 0, &inbox_wait_ops);
+        if (pending->total_n == 0) continue;
+        debug_ipc_print(
+            debug_channel_pending_stats_fmt, executor->local_id, dst, pending->total_n,
+            pending->max_n, pending->waits_n
+        );
+    }
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        while (state->queues[from].head != NULL) {
+            InboxMessage *next = state->queues[from].head->next;
+            free(state->queues[from].head);
+            state->queues[from].head = next;
+        }
+    }
+    free(state->queues);
+    free(state->pending);
+    free(executor->transport_state);
+    free(executor->ch_read);
+    free(executor->ch_write);
+}
+
+int write_inbox_channel(void *self, local_id dst, const Message *msg) {
+    executor     *executor = self;
+    InboxState   *state = executor->transport_state;
+    PendingQueue *pending = &state->pending[dst];
+    char          frame[PIPE_BUF];
+    if (msg->s_header.s_payload_len > MAX_INBOX_PAYLOAD_LEN) return 1;
+    InboxFrameHeader header = {.s_from = executor->local_id, .s_header = msg->s_header};
+    uint32_t         size = sizeof(InboxFrameHeader) + msg->s_header.s_payload_len;
+    int              rc = 0;
+    memcpy(frame, &header, sizeof(InboxFrameHeader));
+    memcpy(frame + sizeof(InboxFrameHeader), msg->s_payload, msg->s_header.s_payload_len);
+    if (pending->n > 0) {
+        // keep order: frame goes after already pending ones
+        rc = push_pending(pending, frame, size);
+        flush_inbox_pending(executor, dst);
+    } else {
+        int written = write_inbox_frame(executor, dst, frame, size);
+        if (written > 0) rc = push_pending(pending, frame, size);
+        // the other process is finished, message is dropped like pipes backend does
+        if (written < 0 && errno != EPIPE) rc = 1;
+    }
+    if (pending->bytes >= PENDING_HIGH_WATER) {
+        pending->waits_n++;
+        debug_ipc_print(debug_channel_high_water_fmt, executor->local_id, dst, pending->bytes);
+        wait_pending_writable(executor, dst, pending, PENDING_HIGH_WATER, &inbox_wait_ops);
+    }
+    return rc;
+}
+
+int read_inbox_channel(void *self, local_id from, Message *msg) {
+    executor   *executor = self;
+    InboxState *state = executor->transport_state;
+    InboxQueue *queue = &state->queues[from];
+    if (queue->head == NULL) drain_inbox(executor);
+    if (queue->head == NULL) return -1;
+
+    InboxMessage *item = queue->head;
+    queue->head = item->next;
+    if (queue->head == NULL) queue->tail = NULL;
+    memcpy(msg, &item->msg, sizeof(MessageHeader) + item->msg.s_header.s_payload_len);
+    free(item);
+    return 0;
+}
+
+/**
+ * @brief      Wait until the inbox pipe has data to read. Inboxes of other processes with pending
+ * frames are waited too, so the other process is not blocked waiting for them.
+ *
+ * @return     1 if inbox is ready or pending frames are written, 0 on timeout, -1 on error
+ */
+int wait_inbox(executor *self, int timeout) {
+    InboxState   *state = self->transport_state;
+    struct pollfd pfds[MAX_PROCESS_ID + 1];
+    local_id      ids[MAX_PROCESS_ID + 1];
+    int           pfds_n = 1;
+    int           rc = 0;
+    pfds[0].fd = self->ch_read[self->local_id];
+    pfds[0].events = POLLIN;
+    for (local_id dst = 0; dst < self->proc_n; ++dst) {
+        if (state->pending[dst].n == 0) continue;
+        pfds[pfds_n].fd = self->ch_write[dst];
+        pfds[pfds_n].events = POLLOUT;
+        ids[pfds_n++] = dst;
+    }
+    while ((rc = poll(pfds, pfds_n, timeout)) < 0 && errno == EINTR) {}
+    if (rc <= 0) return rc;
+    for (int i = 1; i < pfds_n; ++i) {
+        if (pfds[i].revents & POLLERR) {
+            drop_inbox_pending(self, ids[i]);
+        } else if (pfds[i].revents & POLLOUT) {
+            flush_inbox_pending(self, ids[i]);
+        }
+    }
+    return 1;
+}
+
+int wait_inbox_ready(void *self, local_id *ready, int timeout) {
+    executor   *executor = self;
+    InboxState *state = executor->transport_state;
+    if (executor->poll_n == 0) return -1;
+    while (1) {
+        // frames are written while executor spins too, not only when it sleeps in poll
+        flush_inbox_channels(executor);
+        int is_closed = drain_inbox(executor) != 0;
+        int ready_n = 0;
+        for (local_id from = 0; from < executor->proc_n; ++from) {
+            if (executor->poll_state[from] != POLL_ACTIVE) continue;
+            if (state->queues[from].head != NULL) ready[ready_n++] = from;
+        }
+        if (ready_n > 0 || timeout == POLL_NOWAIT) return ready_n;
+        if (is_closed) return -1;
+        int rc = wait_inbox(executor, timeout);
+        if (rc <= 0) return rc;
+    }
+}
+
+int wait_inbox_one_ready(void *self, local_id from, int timeout) {
+    executor   *executor = self;
+    InboxState *state = executor->transport_state;
+    while (1) {
+        flush_inbox_channels(executor);
+        int is_closed = drain_inbox(executor) != 0;
+        if (state->queues[from].head != NULL) return 1;
+        if (timeout == POLL_NOWAIT) return 0;
+        if (is_closed) return -1;
+        int rc = wait_inbox(executor, timeout);
+        if (rc <= 0) return rc;
+    }
+}
+
+const transport inbox_transport = {
+    .name = "inbox",
+    .open = open_inbox_channels,
+    .set_executor = set_executor_inbox_channels,
+    .close_unused = close_unused_inbox_channels,
+    .close = close_inbox_channels,
+    .cleanup = cleanup_executor_inbox_channels,
+    .flush = flush_inbox_channels,
+    .write = write_inbox_channel,
+    .read = read_inbox_channel,
+    .wait_ready = wait_inbox_ready,
+    .wait_one_ready = wait_inbox_one_ready,
+    .mask = mask_poll_state,
+    .unmask = unmask_poll_state,
+};
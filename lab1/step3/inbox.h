@@ -0,0 +1,119 @@
+/**
+ * @file     inbox.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Inbox transport: single pipe per receiver shared by all senders
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_INBOX__H
+#define __ITMO_DISTRIBUTED_CLASS_INBOX__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+/**
+ * Frame written into the inbox pipe before message payload. Whole frame is written with one
+ * call, so frames from different senders never interleave (while frame fits into PIPE_BUF).
+ */
+typedef struct {
+    local_id      s_from;    ///< Sender local id
+    MessageHeader s_header;  ///< Original message header
+} __attribute__((packed)) InboxFrameHeader;
+
+typedef struct InboxMessage {
+    struct InboxMessage *next;  ///< Next message from the same sender
+    Message              msg;   ///< Message (allocated only for header and payload)
+} InboxMessage;
+
+typedef struct {
+    InboxMessage *head;  ///< First message to receive
+    InboxMessage *tail;  ///< Last received message
+} InboxQueue;
+
+/**
+ * Messages read from the inbox, but not received by executor yet (grouped by sender), and frames
+ * which do not fit into full inboxes of other processes
+ */
+typedef struct {
+    InboxQueue   *queues;   ///< Queue of every sender (indexed by sender local id)
+    PendingQueue *pending;  ///< Frames not written yet (indexed by destination local id)
+} InboxState;
+
+/**
+ * @brief      Opens an inbox pipe for every process. Inbox of process i is stored in the channels
+ * matrix diagonal (channels[i][i]), which is not used by pipes matrix.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_inbox_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sets the executor inbox read handler and inbox write handlers of other processes.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      executor  The executor
+ * @param      channels  The channels matrix
+ */
+void set_executor_inbox_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Closes inboxes of other processes read handlers and own inbox write handler.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param[in]  local_id  The local identifier
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_unused_inbox_channels(int16_t proc_n, local_id local_id, channel **channels);
+
+/**
+ * @brief      Closes all inbox pipes.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_inbox_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Writes a message with sender id to the inbox of dst. Frame is written with one call
+ * (it is not longer than PIPE_BUF, so it is atomic). If the inbox is full, frame is kept in the
+ * pending queue and written when the inbox becomes writable. Sender waits for the reader when
+ * pending queue reaches PENDING_HIGH_WATER.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error (e.g. message does not fit into PIPE_BUF)
+ */
+int write_inbox_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Reads a message from process from (messages from other senders are kept in inbox
+ * state queues).
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no message from this process
+ */
+int read_inbox_channel(void *executor, local_id from, Message *msg);
+
+/**
+ * @brief      Writes pending frames to inboxes of other processes until they are full.
+ *
+ * @param      executor  The executor
+ *
+ * @return     0 on success, any non-zero value if some frames are still pending
+ */
+int flush_inbox_channels(void *executor);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_INBOX__H
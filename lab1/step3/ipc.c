@@ -1,13 +1,18 @@
 #include "ipc.h"
 
 #include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "channels.h"
+#include "control.h"
 #include "debug.h"
 #include "executor.h"
 #include "ipc_util.h"
+#include "lane.h"
 #include "time.h"
+#include "transport.h"
+#include "tree.h"
 
 size_t compute_msg_size(const Message *msg) {
     return sizeof(MessageHeader) + msg->s_header.s_payload_len;
@@ -40,14 +45,13 @@ char *get_msg_type_text(const MessageType type) {
 
 int send(void *self, local_id dst, const Message *msg) {
     executor *executor = self;
-    uint16_t  msg_size = compute_msg_size(msg);
-    channel_h channel_h = get_channel_write_h(executor, dst);
-    int       bytes = write(channel_h, msg, msg_size);
+    int       rc = is_tree_enabled() ? send_tree_msg(executor, dst, msg)
+                                     : executor->transport->write(executor, dst, msg);
     debug_ipc_print(
         debug_ipc_send_fmt, get_lamport_time(), executor->local_id, executor->local_id, dst,
-        get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time, bytes, channel_h
+        get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time,
+        rc == 0 ? (int)compute_msg_size(msg) : -1, executor->transport->name
     );
-    int rc = bytes > 0 ? 0 : 1;
     if (rc != 0) {
         debug_ipc_print(
             debug_ipc_send_failed_fmt, get_lamport_time(), executor->local_id, executor->local_id,
@@ -66,6 +70,19 @@ int send_multicast(void *self, const Message *msg) {
         get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time
     );
     int rc = 0;
+    if (is_tree_enabled() || executor->transport->multicast != NULL) {
+        // message is written once for all processes (or to children which forward it)
+        rc = is_tree_enabled() ? multicast_tree_msg(executor, msg)
+                               : executor->transport->multicast(executor, msg);
+        if (rc != 0) {
+            debug_ipc_print("[local_id=%d] send_multicast failed\n", executor->local_id);
+            return rc;
+        }
+        for (int dst = 0; dst < executor->proc_n; ++dst) {
+            if (executor->local_id != dst) executor->last_send_at[dst] = msg->s_header.s_local_time;
+        }
+        return rc;
+    }
     for (int dst = 0; dst < executor->proc_n; ++dst) {
         if (executor->local_id == dst) continue;
         rc = send(executor, dst, msg);
@@ -77,35 +94,85 @@ int send_multicast(void *self, const Message *msg) {
     return rc;
 }
 
-int receive(void *self, local_id from, Message *msg) {
-    executor *executor = self;
-    channel_h channel_h = get_channel_read_h(executor, from);
-    if (channel_h == -1) return -1;
-    int bytes = 0;
-    if ((bytes = read(channel_h, &(msg->s_header), sizeof(MessageHeader))) <= 0) return -1;
-    if (msg->s_header.s_payload_len > 0
-        && (bytes = read(channel_h, msg->s_payload, msg->s_header.s_payload_len)) <= 0)
-        return 1;
+/**
+ * @brief      Update time with received message and print it.
+ */
+void on_received(executor *executor, local_id from, const Message *msg) {
     timestamp_t prev_time = get_lamport_time();
     next_tick(msg->s_header.s_local_time);
     executor->last_recv_at[from] = msg->s_header.s_local_time;
     debug_ipc_print(
         debug_ipc_receive_fmt, get_lamport_time(), executor->local_id, executor->local_id, from,
-        get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time, prev_time, bytes
+        get_msg_type_text(msg->s_header.s_type), msg->s_header.s_local_time, prev_time,
+        (int)compute_msg_size(msg)
     );
+    debug_control_print(msg, from);
+}
+
+int receive(void *self, local_id from, Message *msg) {
+    const Message *borrowed = receive_borrow(self, from);
+    if (borrowed == NULL) return -1;
+    memcpy(msg, borrowed, compute_msg_size(borrowed));
+    receive_release(self, from);
     return 0;
 }
 
+/**
+ * @brief      Borrow the next message of channel from the transport (without lanes). Messages
+ * routed over tree are taken from delivered messages of origin.
+ */
+const Message *borrow_from_transport(executor *executor, local_id from) {
+    if (!is_tree_enabled()) return borrow_channel_msg(executor, from);
+    if (!has_tree_msgs(&executor->tree, from)) pump_tree_channels(executor);
+    return peek_tree_msg(&executor->tree, from);
+}
+
+/**
+ * @brief      Release message borrowed with borrow_from_transport.
+ */
+void release_to_transport(executor *executor, local_id from) {
+    if (is_tree_enabled()) drop_tree_msg(&executor->tree, from);
+    else release_channel_msg(executor, from);
+}
+
+const Message *receive_borrow(void *self, local_id from) {
+    executor      *executor = self;
+    const Message *msg = NULL;
+    // bulk messages are put aside until channel has no control messages, so lock handoff does
+    // not wait for data payloads sent before it (lane of bulk messages stays in FIFO order)
+    while (!is_bulk_lane_full(&executor->lanes, from)) {
+        msg = borrow_from_transport(executor, from);
+        if (msg == NULL) break;
+        if (get_msg_lane(msg->s_header.s_type) == LANE_HIGH) {
+            on_received(executor, from, msg);
+            return msg;
+        }
+        if (push_bulk_msg(&executor->lanes, &executor->msg_pool, from, msg) != 0) {
+            // no memory to put message aside, so it is received in place
+            on_received(executor, from, msg);
+            return msg;
+        }
+        release_to_transport(executor, from);
+    }
+    msg = borrow_bulk_msg(&executor->lanes, from);
+    if (msg != NULL) on_received(executor, from, msg);
+    return msg;
+}
+
+void receive_release(void *self, local_id from) {
+    executor *executor = self;
+    if (executor->lanes.is_borrowed) drop_bulk_msg(&executor->lanes, from);
+    else release_to_transport(executor, from);
+}
+
 int receive_any(void *self, Message *msg) {
     executor *executor = self;
-    int       received_n = 0;
-    local_id  local_id = 0;
-    while (received_n == 0) {
-        if (local_id == executor->proc_n - 1) usleep(SLEEP_RECEIVE_USEC);
-        local_id = (local_id + 1) % executor->proc_n;
-        if (executor->local_id == local_id) continue;
-        int rc = receive(executor, local_id, msg);
-        received_n += (rc == 0);
+    local_id  ready[MAX_PROCESS_ID + 1];
+    while (1) {
+        int ready_n = wait_channels_ready(executor, ready, POLL_BLOCK);
+        if (ready_n < 0) return -1;
+        for (int i = 0; i < ready_n; ++i) {
+            if (receive(executor, ready[i], msg) == 0) return 0;
+        }
     }
-    return 0;
 }
@@ -16,10 +16,10 @@
 
 //------------------------------------------------------------------------------
 
-typedef int8_t  local_id;
-typedef int16_t timestamp_t;
+typedef int16_t local_id;
+typedef int32_t timestamp_t;
 
-enum { MESSAGE_MAGIC = 0xAFAF, MAX_MESSAGE_LEN = 4096, PARENT_ID = 0, MAX_PROCESS_ID = 15 };
+enum { MESSAGE_MAGIC = 0xAFAF, MAX_MESSAGE_LEN = 4096, PARENT_ID = 0, MAX_PROCESS_ID = 1024 };
 
 typedef enum {
     STARTED = 0,      ///< message with string (doesn't include trailing '\0')
@@ -18,4 +18,26 @@
  */
 char *get_msg_type_text(const MessageType type);
 
+/**
+ * @brief      Receive a message from the process by its local id without copying it: returned
+ * message points into the transport receive buffer (or ring slot) and stays valid until
+ * receive_release. Only one message of the executor can be borrowed at a time, and the channel is
+ * not read until the message is released. Control messages are received before bulk messages of
+ * the channel which are sent earlier (see lane.h), bulk messages keep their order.
+ *
+ * @param      self  Any data structure implemented by students to perform I/O
+ * @param[in]  from  ID of the process to receive message from
+ *
+ * @return     The read-only message, NULL if there is no message or on error
+ */
+const Message *receive_borrow(void *self, local_id from);
+
+/**
+ * @brief      Release a message returned by receive_borrow.
+ *
+ * @param      self  Any data structure implemented by students to perform I/O
+ * @param[in]  from  ID of the process message is received from
+ */
+void receive_release(void *self, local_id from);
+
 #endif  // __IFMO_DISTRIBUTED_CLASS_IPC_UTIL__H
@@ -0,0 +1,105 @@
+#include "lane.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ipc.h"
+#include "ipc_util.h"
+#include "msgpool.h"
+
+// data payloads go behind control messages unless configured otherwise
+static uint8_t msg_lanes[LANE_TYPE_N] = {
+    [TRANSFER] = LANE_BULK,
+    [BALANCE_HISTORY] = LANE_BULK,
+};
+
+/**
+ * @brief      Finds message type by name of len chars.
+ *
+ * @return     The message type or -1 if name is unknown.
+ */
+int find_msg_type(const char *name, size_t len) {
+    for (int type = 0; type < LANE_TYPE_N; ++type) {
+        const char *text = get_msg_type_text(type);
+        if (strlen(text) == len && strncmp(text, name, len) == 0) return type;
+    }
+    return -1;
+}
+
+int set_bulk_msg_types(const char *types) {
+    uint8_t lanes[LANE_TYPE_N] = {0};
+    for (const char *name = types; *name != '\0'; name += *name == ',') {
+        size_t len = strcspn(name, ",");
+        int    type = find_msg_type(name, len);
+        if (type < 0) return -1;
+        lanes[type] = LANE_BULK;
+        name += len;
+    }
+    memcpy(msg_lanes, lanes, sizeof(msg_lanes));
+    return 0;
+}
+
+MessageLane get_msg_lane(int16_t type) {
+    if (type < 0 || type >= LANE_TYPE_N) return LANE_HIGH;
+    return msg_lanes[type];
+}
+
+void init_lanes(LaneState *lanes, int16_t proc_n) {
+    memset(lanes, 0, sizeof(LaneState));
+    lanes->bulk = calloc(proc_n, sizeof(LaneQueue *));
+    lanes->proc_n = proc_n;
+}
+
+void destroy_lanes(LaneState *lanes) {
+    for (int from = 0; from < lanes->proc_n; ++from) {
+        LaneQueue *queue = lanes->bulk[from];
+        if (queue == NULL) continue;
+        for (; queue->n > 0; --queue->n) {
+            release_msg(queue->msgs[queue->head]);
+            queue->head = (queue->head + 1) % LANE_QUEUE_SIZE;
+        }
+        free(queue);
+    }
+    free(lanes->bulk);
+    lanes->bulk = NULL;
+    lanes->proc_n = 0;
+    lanes->is_borrowed = 0;
+}
+
+int is_bulk_lane_full(const LaneState *lanes, local_id from) {
+    return lanes->bulk[from] != NULL && lanes->bulk[from]->n == LANE_QUEUE_SIZE;
+}
+
+int has_bulk_msgs(const LaneState *lanes, local_id from) {
+    return lanes->bulk[from] != NULL && lanes->bulk[from]->n > 0;
+}
+
+int push_bulk_msg(LaneState *lanes, MsgPool *pool, local_id from, const Message *msg) {
+    // most channels never carry bulk messages, so lanes are allocated on demand
+    if (lanes->bulk[from] == NULL) lanes->bulk[from] = calloc(1, sizeof(LaneQueue));
+    LaneQueue *queue = lanes->bulk[from];
+    if (queue == NULL || queue->n == LANE_QUEUE_SIZE) return -1;
+    Message *copy = clone_msg(pool, msg);
+    if (copy == NULL) return -1;
+    queue->msgs[(queue->head + queue->n) % LANE_QUEUE_SIZE] = copy;
+    queue->n++;
+    lanes->deferred_n++;
+    return 0;
+}
+
+const Message *borrow_bulk_msg(LaneState *lanes, local_id from) {
+    if (!has_bulk_msgs(lanes, from)) return NULL;
+    LaneQueue *queue = lanes->bulk[from];
+    lanes->is_borrowed = 1;
+    return queue->msgs[queue->head];
+}
+
+void drop_bulk_msg(LaneState *lanes, local_id from) {
+    if (!lanes->is_borrowed || !has_bulk_msgs(lanes, from)) return;
+    LaneQueue *queue = lanes->bulk[from];
+    release_msg(queue->msgs[queue->head]);
+    queue->head = (queue->head + 1) % LANE_QUEUE_SIZE;
+    queue->n--;
+    lanes->is_borrowed = 0;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file     lane.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Priority lanes of channels: control messages overtake bulk payloads
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_LANE__H
+#define __ITMO_DISTRIBUTED_CLASS_LANE__H
+
+#include <stdint.h>
+
+#include "ipc.h"
+#include "msgpool.h"
+
+#define LANE_TYPE_N     16  // size of message type to lane map (all MessageType values are less)
+#define LANE_QUEUE_SIZE 32  // max number of bulk messages buffered for one channel
+
+typedef enum {
+    LANE_HIGH,  ///< Control messages (lock, start, stop), always received first
+    LANE_BULK,  ///< Data messages, received when there is no control message in channel
+} MessageLane;
+
+/**
+ * Bulk lane of one channel: ring of pooled messages which are read from transport ahead of
+ * control messages and wait until channel has no control messages.
+ */
+typedef struct {
+    Message *msgs[LANE_QUEUE_SIZE];  ///< Pooled messages (hold by lane)
+    uint8_t  head;                   ///< Index of the first message
+    uint8_t  n;                      ///< Number of buffered messages
+} LaneQueue;
+
+typedef struct {
+    LaneQueue **bulk;         ///< Bulk lane of every reading channel (allocated on first use)
+    uint16_t    proc_n;       ///< Number of channels
+    uint8_t     is_borrowed;  ///< Head of bulk lane is borrowed by receiver
+    uint32_t    deferred_n;   ///< Number of bulk messages read ahead of control messages
+} LaneState;
+
+/**
+ * @brief      Set message types received in bulk lane, all other types are received in high lane.
+ *
+ * @param[in]  types  Comma separated message type names (e.g. "TRANSFER,BALANCE_HISTORY"), empty
+ *                    string puts all types to high lane
+ *
+ * @return     0 on success, -1 on unknown type name
+ */
+int set_bulk_msg_types(const char *types);
+
+/**
+ * @brief      Gets the lane of message type.
+ *
+ * @param[in]  type  The message type
+ *
+ * @return     The lane (LANE_HIGH for unknown types).
+ */
+MessageLane get_msg_lane(int16_t type);
+
+/**
+ * @brief      Initializes empty lanes.
+ *
+ * @param      lanes   The lanes
+ * @param[in]  proc_n  The number of processes
+ */
+void init_lanes(LaneState *lanes, int16_t proc_n);
+
+/**
+ * @brief      Releases all buffered messages and lanes.
+ *
+ * @param      lanes  The lanes
+ */
+void destroy_lanes(LaneState *lanes);
+
+/**
+ * @brief      Determines if bulk lane of channel can not buffer more messages.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ *
+ * @return     1 if lane is full, 0 otherwise.
+ */
+int is_bulk_lane_full(const LaneState *lanes, local_id from);
+
+/**
+ * @brief      Determines if bulk lane of channel has buffered messages.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ *
+ * @return     1 if lane is not empty, 0 otherwise.
+ */
+int has_bulk_msgs(const LaneState *lanes, local_id from);
+
+/**
+ * @brief      Copies message to the tail of channel bulk lane.
+ *
+ * @param      lanes  The lanes
+ * @param      pool   The pool to copy message to
+ * @param[in]  from   The channel source local id
+ * @param[in]  msg    The message (can be released by caller after call)
+ *
+ * @return     0 on success, -1 if lane is full or message can not be allocated.
+ */
+int push_bulk_msg(LaneState *lanes, MsgPool *pool, local_id from, const Message *msg);
+
+/**
+ * @brief      Borrows the head of channel bulk lane until drop_bulk_msg.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ *
+ * @return     The message or NULL if lane is empty.
+ */
+const Message *borrow_bulk_msg(LaneState *lanes, local_id from);
+
+/**
+ * @brief      Removes borrowed head of channel bulk lane.
+ *
+ * @param      lanes  The lanes
+ * @param[in]  from   The channel source local id
+ */
+void drop_bulk_msg(LaneState *lanes, local_id from);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_LANE__H
@@ -0,0 +1,368 @@
+#include "lazy.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/epoll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "bitset.h"
+#include "channels.h"
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "packet.h"
+#include "transport.h"
+
+/**
+ * @brief      Send packet to the process control socket (broker side).
+ *
+ * @return     0 on success, any non-zero value if process is finished
+ */
+int send_lazy_packet(
+    struct pollfd *sockets, local_id to, LazyPacketType type, local_id peer, int passed_fd
+) {
+    LazyPacket packet = {.type = type, .peer = peer};
+    if (sockets[to].fd < 0) return 1;
+    return send_packet_fd(sockets[to].fd, &packet, sizeof(packet), passed_fd) < 0;
+}
+
+/**
+ * @brief      Create pipe from -> dst and pass its ends to both processes. Read end is passed
+ * first, so reader knows about the channel before any message is written into it.
+ */
+void grant_lazy_channel(
+    int16_t proc_n, struct pollfd *sockets, bitset_word *opened, local_id from, local_id dst
+) {
+    channel ch;
+    if (dst < 0 || dst >= proc_n || dst == from || is_bit_set(opened, from * proc_n + dst)) {
+        send_lazy_packet(sockets, from, LAZY_REFUSED, dst, -1);
+        return;
+    }
+    if (sockets[dst].fd < 0 || init_channel(&ch) != 0) {
+        send_lazy_packet(sockets, from, LAZY_REFUSED, dst, -1);
+        return;
+    }
+    set_bit(opened, from * proc_n + dst);
+    if (send_lazy_packet(sockets, dst, LAZY_READ_END, from, ch.read_h) != 0) {
+        send_lazy_packet(sockets, from, LAZY_REFUSED, dst, -1);
+    } else {
+        send_lazy_packet(sockets, from, LAZY_WRITE_END, dst, ch.write_h);
+    }
+    close_channel_handler(&ch.read_h);
+    close_channel_handler(&ch.write_h);
+}
+
+/**
+ * @brief      Close control socket of finished process and tell other processes that channels from
+ * it are never opened.
+ */
+void finish_lazy_process(int16_t proc_n, struct pollfd *sockets, bitset_word *opened, local_id id) {
+    close_channel_handler(&sockets[id].fd);
+    for (local_id other_id = 0; other_id < proc_n; ++other_id) {
+        if (other_id == id || is_bit_set(opened, id * proc_n + other_id)) continue;
+        set_bit(opened, id * proc_n + other_id);
+        send_lazy_packet(sockets, other_id, LAZY_CLOSED, id, -1);
+    }
+}
+
+/**
+ * @brief      Broker process loop: serve channel requests until all processes are finished.
+ */
+void run_lazy_broker(int16_t proc_n, channel **channels) {
+    struct pollfd *sockets = malloc(proc_n * sizeof(struct pollfd));
+    bitset_word   *opened = new_bitset(proc_n * proc_n);  // channels from -> dst which are opened
+    int            alive_n = proc_n;
+    if (sockets == NULL || opened == NULL) {
+        perror("Failed to start lazy channels broker");
+        // executors get end of control sockets instead of waiting for grants forever
+        for (local_id id = 0; id < proc_n; ++id) close_channel(channels, id, id);
+        _exit(1);
+    }
+    for (local_id id = 0; id < proc_n; ++id) {
+        close_channel_handler(&channels[id][id].read_h);
+        sockets[id].fd = channels[id][id].write_h;
+        sockets[id].events = POLLIN;
+    }
+    while (alive_n > 0) {
+        if (poll(sockets, proc_n, POLL_BLOCK) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        for (local_id id = 0; id < proc_n; ++id) {
+            if (sockets[id].fd < 0 || sockets[id].revents == 0) continue;
+            LazyPacket packet;
+            ssize_t    bytes = recv_packet(sockets[id].fd, &packet, sizeof(packet));
+            if (bytes == sizeof(packet) && packet.type == LAZY_REQUEST) {
+                grant_lazy_channel(proc_n, sockets, opened, id, packet.peer);
+            } else if (bytes == 0 || (bytes < 0 && errno != EAGAIN)) {
+                finish_lazy_process(proc_n, sockets, opened, id);
+                alive_n--;
+            }
+        }
+    }
+    _exit(0);
+}
+
+int open_lazy_channels(int16_t proc_n, channel **channels) {
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = 0; dst < proc_n; ++dst) {
+            channels[from][dst].read_h = -1;
+            channels[from][dst].write_h = -1;
+        }
+    }
+    for (local_id id = 0; id < proc_n; ++id) {
+        int fd[2];
+        if (open_packet_pair(fd) != 0) return 1;
+        channels[id][id].read_h = fd[0];
+        channels[id][id].write_h = fd[1];
+        debug_print(debug_channel_open_fmt, id, id, 0, fd[0], fd[1]);
+    }
+    // broker is detached (started by a short-living process), so waiting for executor processes
+    // does not wait for the broker
+    pid_t pid = fork();
+    if (pid < 0) return 1;
+    if (pid == 0) {
+        if (fork() == 0) run_lazy_broker(proc_n, channels);
+        _exit(0);
+    }
+    waitpid(pid, NULL, 0);
+    for (local_id id = 0; id < proc_n; ++id) close_channel_handler(&channels[id][id].write_h);
+    return 0;
+}
+
+void set_executor_lazy_channels(int16_t proc_n, void *self, channel **channels) {
+    executor  *executor = self;
+    LazyState *state = calloc(1, sizeof(LazyState));
+    init_pipe_state(&state->pipes, proc_n);
+    // control socket is owned by executor state from now
+    state->broker_h = channels[executor->local_id][executor->local_id].read_h;
+    channels[executor->local_id][executor->local_id].read_h = -1;
+    state->refused = new_bitset(proc_n);
+    executor->transport_state = state;
+    executor->ch_read = malloc(proc_n * sizeof(channel_h));
+    executor->ch_write = malloc(proc_n * sizeof(channel_h));
+    executor->poll_n = 0;
+    executor->poll_h = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event = {.events = EPOLLIN, .data.u32 = POLL_BROKER_TAG};
+    if (executor->poll_h < 0
+        || epoll_ctl(executor->poll_h, EPOLL_CTL_ADD, state->broker_h, &event) != 0) {
+        perror("Failed to init channels poll");
+    }
+    for (local_id other_id = 0; other_id < proc_n; ++other_id) {
+        executor->ch_read[other_id] = -1;
+        executor->ch_write[other_id] = -1;
+        executor->poll_state[other_id] = other_id == executor->local_id ? POLL_CLOSED : POLL_ACTIVE;
+        executor->poll_n += other_id != executor->local_id;
+    }
+}
+
+int close_unused_lazy_channels(int16_t proc_n, local_id local_id, channel **channels) {
+    for (int id = 0; id < proc_n; ++id) {
+        if (id != local_id) close_channel(channels, id, id);
+    }
+    return 0;
+}
+
+int close_lazy_channels(int16_t proc_n, channel **channels) {
+    for (local_id id = 0; id < proc_n; ++id) close_channel(channels, id, id);
+    return 0;
+}
+
+/**
+ * @brief      Attach read end of channel from -> self. Channel is added to poll if process waits
+ * for it (it is already counted in poll_n).
+ */
+void attach_lazy_read_end(executor *executor, local_id from, channel_h read_h) {
+    LazyState *state = executor->transport_state;
+    executor->ch_read[from] = read_h;
+    state->accepted_n++;
+    if (executor->poll_state[from] != POLL_ACTIVE) return;
+    executor->poll_n--;
+    if (ctl_channel_poll(executor, EPOLL_CTL_ADD, from) != 0) {
+        executor->poll_state[from] = POLL_CLOSED;
+    }
+}
+
+/**
+ * @brief      Close channel from -> self which is never opened.
+ */
+void close_lazy_read_end(executor *executor, local_id from) {
+    if (executor->ch_read[from] != -1 || executor->poll_state[from] == POLL_CLOSED) return;
+    if (executor->poll_state[from] == POLL_ACTIVE) executor->poll_n--;
+    executor->poll_state[from] = POLL_CLOSED;
+}
+
+int accept_lazy_grants(void *self) {
+    executor  *executor = self;
+    LazyState *state = executor->transport_state;
+    LazyPacket packet;
+    int        passed_fd = -1;
+    ssize_t    bytes = 0;
+    while ((bytes = recv_packet_fd(state->broker_h, &packet, sizeof(packet), &passed_fd)) > 0) {
+        local_id peer = packet.peer;
+        if (peer < 0 || peer >= executor->proc_n) {
+            close_channel_handler(&passed_fd);
+            continue;
+        }
+        switch (packet.type) {
+            case LAZY_READ_END:
+                attach_lazy_read_end(executor, peer, passed_fd);
+                break;
+            case LAZY_WRITE_END:
+                executor->ch_write[peer] = passed_fd;
+                state->opened_n++;
+                log_pipes_msg(log_lazy_channel_opened_fmt, executor->local_id, peer, passed_fd);
+                break;
+            case LAZY_CLOSED:
+                close_lazy_read_end(executor, peer);
+                break;
+            case LAZY_REFUSED:
+                set_bit(state->refused, peer);
+                break;
+            default:
+                close_channel_handler(&passed_fd);
+        }
+    }
+    return bytes == 0 ? -1 : 0;
+}
+
+/**
+ * @brief      Determines if channel self -> dst is granted or can not be granted anymore.
+ */
+int is_lazy_request_done(executor *executor, local_id dst) {
+    LazyState *state = executor->transport_state;
+    return executor->ch_write[dst] != -1 || is_bit_set(state->refused, dst);
+}
+
+/**
+ * @brief      Ask broker for channel self -> dst (if it is not requested yet).
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int request_lazy_channel(executor *executor, local_id dst) {
+    LazyState *state = executor->transport_state;
+    LazyPacket packet = {.type = LAZY_REQUEST, .peer = dst};
+    if (is_lazy_request_done(executor, dst)) return 0;
+    return send_packet_fd(state->broker_h, &packet, sizeof(packet), -1) < 0;
+}
+
+/**
+ * @brief      Wait until broker answers requests of channels to all processes in dsts.
+ *
+ * @return     0 on success, any non-zero value if broker is finished
+ */
+int wait_lazy_requests(executor *executor, const local_id *dsts, int dsts_n) {
+    LazyState    *state = executor->transport_state;
+    struct pollfd pfd = {.fd = state->broker_h, .events = POLLIN};
+    for (int i = 0; i < dsts_n; ++i) {
+        while (!is_lazy_request_done(executor, dsts[i])) {
+            if (poll(&pfd, 1, POLL_BLOCK) < 0 && errno == EINTR) continue;
+            if (accept_lazy_grants(executor) != 0) return 1;
+        }
+    }
+    return 0;
+}
+
+int write_lazy_channel(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    if (executor->ch_write[dst] == -1) {
+        if (request_lazy_channel(executor, dst) != 0) return 1;
+        if (wait_lazy_requests(executor, &dst, 1) != 0) return 1;
+        // peer is finished, so message can not be delivered
+        if (executor->ch_write[dst] == -1) return 1;
+    }
+    return write_channel(executor, dst, msg);
+}
+
+int multicast_lazy_channel(void *self, const Message *msg) {
+    executor *executor = self;
+    local_id  dsts[MAX_PROCESS_ID + 1];
+    int       dsts_n = 0;
+    int       rc = 0;
+    // all missing channels are requested at once, so there is only one round trip to the broker
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst == executor->local_id || executor->ch_write[dst] != -1) continue;
+        if (request_lazy_channel(executor, dst) != 0) return 1;
+        dsts[dsts_n++] = dst;
+    }
+    if (wait_lazy_requests(executor, dsts, dsts_n) != 0) return 1;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst == executor->local_id) continue;
+        if (executor->ch_write[dst] == -1) rc = 1;
+        else rc |= write_channel(executor, dst, msg);
+    }
+    return rc;
+}
+
+int wait_lazy_one_ready(void *self, local_id from, int timeout) {
+    executor     *executor = self;
+    LazyState    *state = executor->transport_state;
+    struct pollfd pfd = {.fd = state->broker_h, .events = POLLIN};
+    int           rc = 0;
+    if (accept_lazy_grants(executor) != 0) return -1;
+    while (executor->ch_read[from] == -1) {
+        if (executor->poll_state[from] == POLL_CLOSED) return -1;
+        while ((rc = poll(&pfd, 1, timeout)) < 0 && errno == EINTR) {}
+        if (rc <= 0) return rc;
+        if (accept_lazy_grants(executor) != 0) return -1;
+    }
+    return wait_pipe_ready(executor, from, timeout);
+}
+
+void mask_lazy_poll(void *self, local_id from) {
+    executor *executor = self;
+    if (executor->ch_read[from] != -1) {
+        mask_pipe_poll(executor, from);
+    } else if (executor->poll_state[from] == POLL_ACTIVE) {
+        executor->poll_n--;
+        executor->poll_state[from] = POLL_MASKED;
+    }
+}
+
+void unmask_lazy_poll(void *self) {
+    executor *executor = self;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (executor->ch_read[from] != -1 || executor->poll_state[from] != POLL_MASKED) continue;
+        executor->poll_n++;
+        executor->poll_state[from] = POLL_ACTIVE;
+    }
+    unmask_pipes_poll(executor);
+}
+
+void cleanup_executor_lazy_channels(void *self) {
+    executor  *executor = self;
+    LazyState *state = executor->transport_state;
+    channel_h  broker_h = state->broker_h;
+    debug_ipc_print(
+        debug_lazy_channels_stats_fmt, executor->local_id, state->opened_n, state->accepted_n
+    );
+    free(state->refused);
+    // pipes state is freed with the whole lazy state
+    cleanup_executor_channels(executor);
+    // broker finishes channels which are not opened for this process
+    close_channel_handler(&broker_h);
+}
+
+const transport lazy_transport = {
+    .name = "lazy",
+    .open = open_lazy_channels,
+    .set_executor = set_executor_lazy_channels,
+    .close_unused = close_unused_lazy_channels,
+    .close = close_lazy_channels,
+    .cleanup = cleanup_executor_lazy_channels,
+    .flush = flush_channels,
+    .write = write_lazy_channel,
+    .multicast = multicast_lazy_channel,
+    .read = read_channel,
+    .borrow = borrow_channel,
+    .release = release_channel,
+    .wait_ready = wait_pipes_ready,
+    .wait_one_ready = wait_lazy_one_ready,
+    .mask = mask_lazy_poll,
+    .unmask = unmask_lazy_poll,
+};
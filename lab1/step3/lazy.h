@@ -0,0 +1,98 @@
+/**
+ * @file     lazy.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Lazy pipes transport: pipes are created by a broker process on the first send and
+ * passed to both processes over control sockets (SCM_RIGHTS)
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_LAZY__H
+#define __ITMO_DISTRIBUTED_CLASS_LAZY__H
+
+#include <stdint.h>
+
+#include "bitset.h"
+#include "channels.h"
+#include "ipc.h"
+
+typedef enum {
+    LAZY_REQUEST,    ///< Process asks broker for channel to peer
+    LAZY_READ_END,   ///< Read end of channel peer -> process is attached
+    LAZY_WRITE_END,  ///< Write end of channel process -> peer is attached
+    LAZY_CLOSED,     ///< Peer is finished without opening channel to process
+    LAZY_REFUSED,    ///< Requested channel is not opened, peer is finished
+} LazyPacketType;
+
+/**
+ * Packet of control socket between process and broker
+ */
+typedef struct {
+    int16_t  type;  ///< Packet type (LazyPacketType)
+    local_id peer;  ///< Other process of the channel
+} LazyPacket;
+
+/**
+ * Lazy pipes backend executor state. Granted pipes are used by pipes backend functions, so pipes
+ * state is the first field. Channel which is not granted yet has -1 handler, while it is active it
+ * is counted in poll_n (process still waits for messages from it).
+ */
+typedef struct {
+    PipeState    pipes;       ///< Pipes state of granted channels
+    channel_h    broker_h;    ///< Control socket to the broker
+    bitset_word *refused;     ///< Processes which are finished before channel to them is requested
+    uint16_t     opened_n;    ///< Number of granted write ends
+    uint16_t     accepted_n;  ///< Number of granted read ends
+} LazyState;
+
+/**
+ * @brief      Opens a control socket pair for every process and starts the broker process. Process
+ * socket is stored in the channels matrix diagonal (channels[i][i].read_h), broker sockets are
+ * closed in this process.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_lazy_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sets the executor control socket, all channels are not granted yet.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      executor  The executor
+ * @param      channels  The channels matrix
+ */
+void set_executor_lazy_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Closes control sockets of other processes.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param[in]  local_id  The local id of process
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_unused_lazy_channels(int16_t proc_n, local_id local_id, channel **channels);
+
+/**
+ * @brief      Closes all control sockets.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_lazy_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Handles all packets received from the broker: attaches granted channels and closes
+ * channels of finished processes.
+ *
+ * @param      executor  The executor
+ *
+ * @return     0 on success, -1 if broker is finished
+ */
+int accept_lazy_grants(void *executor);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_LAZY__H
@@ -2,6 +2,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "channels.h"
@@ -14,8 +15,10 @@
 
 void print_queue(executor* self) {
     if (!get_debug_worker()) return;
-    char buffer[256];
-    int  printed = 0;
+    // queue part is at most "[2147483647, 1024]" (time and id)
+    char *buffer = malloc(64 + 20 * self->lock.queue.size);
+    int   printed = 0;
+    if (buffer == NULL) return;
     printed += sprintf(
         buffer, debug_lock_queue_fmt, get_lamport_time(), self->local_id,
         self->lock.active_request.s_time, self->lock.queue.size
@@ -27,10 +30,11 @@ void print_queue(executor* self) {
         );
     }
     debug_worker_print("%s\n", buffer);
+    free(buffer);
 }
 
 void push_request(executor* self, LockRequest* req) {
-    uint8_t idx = 0;  // index of item where to insert new request
+    uint16_t idx = 0;  // index of item where to insert new request
     if (self->lock.queue.size > 0) {
         while (idx < self->lock.queue.size && self->lock.queue.buffer[idx].s_time < req->s_time) {
             idx++;
@@ -55,10 +59,8 @@ void push_request(executor* self, LockRequest* req) {
      * X X X X X  N  Y Y Y
      */
     if (idx < self->lock.queue.size) {
-        LockRequest buffer[MAX_PROCESS_ID + 1];
-        memcpy(buffer, self->lock.queue.buffer, sizeof(LockRequest) * self->lock.queue.size);
-        memcpy(
-            self->lock.queue.buffer + idx + 1, buffer + idx,
+        memmove(
+            self->lock.queue.buffer + idx + 1, self->lock.queue.buffer + idx,
             sizeof(LockRequest) * (self->lock.queue.size - idx)
         );
     }
@@ -78,7 +80,7 @@ void pop_request(executor* self, local_id from) {
      * 0 1 2 3 4 5 6 7
      * X X X X X Y Y Y
      */
-    uint8_t idx = 0;  // index of item we want to remove
+    uint16_t idx = 0;  // index of item we want to remove
     for (idx = 0; idx < self->lock.queue.size; ++idx) {
         if (self->lock.queue.buffer[idx].s_id == from) break;
     }
@@ -89,10 +91,8 @@ void pop_request(executor* self, local_id from) {
         self->lock.queue.buffer[idx].s_time, self->lock.queue.buffer[idx].s_id, from, idx
     );
     if (idx < self->lock.queue.size - 1) {
-        LockRequest buffer[MAX_PROCESS_ID + 1];
-        memcpy(buffer, self->lock.queue.buffer, sizeof(LockRequest) * self->lock.queue.size);
-        memcpy(
-            self->lock.queue.buffer + idx, buffer + idx + 1,
+        memmove(
+            self->lock.queue.buffer + idx, self->lock.queue.buffer + idx + 1,
             sizeof(LockRequest) * (self->lock.queue.size - idx - 1)
         );
     }
@@ -103,11 +103,19 @@ void pop_request(executor* self, local_id from) {
 void init_lock(void* s_self) {
     executor* self = s_self;
     self->lock.state = LOCK_INACTIVE;
+    self->lock.queue.buffer = malloc(self->proc_n * sizeof(LockRequest));
     self->lock.queue.size = 0;
     self->lock.active_request.s_id = self->local_id;
     self->lock.active_request.s_time = 0;
 }
 
+void destroy_lock(void* s_self) {
+    executor* self = s_self;
+    free(self->lock.queue.buffer);
+    self->lock.queue.buffer = NULL;
+    self->lock.queue.size = 0;
+}
+
 /**
  * @brief      Determines ability to activate self->lock.
  *
@@ -121,18 +129,18 @@ int can_activate_lock(executor* self) {
     return 1;
 }
 
-void on_request_cs(void* s_self, Message* msg, local_id from) {
+void on_request_cs(void* s_self, const Message* msg, local_id from) {
     executor*   self = s_self;
     LockRequest req = {.s_id = from, .s_time = msg->s_header.s_local_time};
     push_request(self, &req);
     send_reply_cs_msg(self, from);
 }
 
-void on_reply_cs(void* s_self, Message* msg, local_id from) {
+void on_reply_cs(void* s_self, const Message* msg, local_id from) {
     // do nothing because we just waiting incoming messages after timestamp
 }
 
-void on_release_cs(void* s_self, Message* msg, local_id from) {
+void on_release_cs(void* s_self, const Message* msg, local_id from) {
     executor* self = s_self;
     pop_request(self, from);
 }
@@ -153,7 +161,7 @@ int request_cs(const void* s_self) {
         print_queue(self);
 
         while (!can_activate_lock(self)) {
-            if (receive_any_cb(self, on_message) != 0) usleep(SLEEP_RECEIVE_USEC);
+            if (wait_receive_any_cb(self, on_message) != 0) return 1;
         }
 
         self->lock.state = LOCK_ACTIVE;
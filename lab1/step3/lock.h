@@ -23,8 +23,8 @@ typedef struct {
 } LockRequest;
 
 typedef struct {
-    LockRequest buffer[MAX_PROCESS_ID + 1];
-    uint16_t    size;
+    LockRequest *buffer;  ///< Requests sorted by time and id (one per process at most)
+    uint16_t     size;
 } LockQueue;
 
 typedef struct {
@@ -40,7 +40,7 @@ typedef struct {
  * @param      msg   The message
  * @param[in]  from  The from process id
  */
-void on_request_cs(void* self, Message* msg, local_id from);
+void on_request_cs(void* self, const Message* msg, local_id from);
 
 /**
  * @brief      Called on reply lock.
@@ -49,7 +49,7 @@ void on_request_cs(void* self, Message* msg, local_id from);
  * @param      msg   The message
  * @param[in]  from  The from process id
  */
-void on_reply_cs(void* self, Message* msg, local_id from);
+void on_reply_cs(void* self, const Message* msg, local_id from);
 
 /**
  * @brief      Called on release lock.
@@ -58,7 +58,7 @@ void on_reply_cs(void* self, Message* msg, local_id from);
  * @param      msg   The message
  * @param[in]  from  The from process id
  */
-void on_release_cs(void* self, Message* msg, local_id from);
+void on_release_cs(void* self, const Message* msg, local_id from);
 
 /**
  * @brief      Initializes the lock.
@@ -67,4 +67,11 @@ void on_release_cs(void* self, Message* msg, local_id from);
  */
 void init_lock(void* self);
 
+/**
+ * @brief      Frees the lock queue.
+ *
+ * @param      self  The executor
+ */
+void destroy_lock(void* self);
+
 #endif  // __ITMO_DISTRIBUTED_CLASS_LOCK__H
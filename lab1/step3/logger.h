@@ -12,6 +12,32 @@
 static const char *const log_channel_opened_fmt
     = "Channel opened (%2d -> %2d) [w] -> [r] [%2d] -> [%2d]\n";
 
+static const char *const log_shm_channel_opened_fmt
+    = "Channel opened (%2d -> %2d) [shm ring] [size=%d]\n";
+
+static const char *const log_inbox_channel_opened_fmt
+    = "Channel opened ( * -> %2d) [w] -> [r] [%2d] -> [%2d] [inbox]\n";
+
+static const char *const log_inbox_channel_closed_fmt = "Channel closed ( * -> %2d) [inbox]\n";
+
+static const char *const log_seqpacket_channel_opened_fmt
+    = "Channel opened (%2d <-> %2d) [s] <-> [s] [%2d] <-> [%2d] [seqpacket]\n";
+
+static const char *const log_tcp_listener_opened_fmt
+    = "Listener opened (%2d) [l] [%2d] [tcp %s:%d]\n";
+
+static const char *const log_tcp_channel_opened_fmt
+    = "Channel opened (%2d <-> %2d) [s] [%2d] [tcp %s:%d]\n";
+
+static const char *const log_sim_channel_opened_fmt
+    = "Channel opened (%2d -> %2d) [sim latency=%llu jitter=%llu bandwidth=%llu]\n";
+
+static const char *const log_sim_finished_fmt
+    = "Simulation finished [time=%llu us] [messages=%llu] [bytes=%llu] [seed=%llu]\n";
+
+static const char *const log_lazy_channel_opened_fmt
+    = "Channel opened (%2d -> %2d) [w] [%2d] [lazy]\n";
+
 static const char *const log_channel_closed_fmt = "Channel closed (%2d -> %2d)\n";
 
 /**
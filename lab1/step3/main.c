@@ -1,3 +1,4 @@
+#include <pthread.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -8,9 +9,13 @@
 #include "args.h"
 #include "channels.h"
 #include "common.h"
+#include "coroutine.h"
 #include "debug.h"
 #include "ipc.h"
 #include "logger.h"
+#include "sim.h"
+#include "tcp.h"
+#include "transport.h"
 #include "worker.h"
 
 int is_parent(pid_t parent_pid) {
@@ -19,7 +24,7 @@ int is_parent(pid_t parent_pid) {
 
 void create_child_process(
     int proc_n, pid_t parent_pid, int local_id, executor *executor, channel **channels,
-    uint8_t use_lock
+    const transport *transport, const wait_policy *wait_policy, uint8_t use_lock
 ) {
     // fork only main parent process
     if (!is_parent(parent_pid)) return;
@@ -28,7 +33,9 @@ void create_child_process(
         // forked process
         pid_t pid = getpid();
         pid_t p_pid = getppid();
-        init_executor(executor, channels, local_id, proc_n, pid, p_pid, use_lock);
+        init_executor(
+            executor, channels, transport, wait_policy, local_id, proc_n, pid, p_pid, use_lock
+        );
         debug_print(debug_forked_fmt, pid, p_pid, local_id);
     }
 }
@@ -41,18 +48,92 @@ void create_processes(
 
     for (int local_id = 1; local_id < arguments->proc_n; ++local_id) {
         create_child_process(
-            arguments->proc_n, parent_pid, local_id, executor, channels, arguments->use_lock
+            arguments->proc_n, parent_pid, local_id, executor, channels, arguments->transport,
+            arguments->wait_policy, arguments->use_lock
         );
     }
     if (is_parent(parent_pid)) {
         init_executor(
-            executor, channels, PARENT_ID, arguments->proc_n, getpid(), 0, arguments->use_lock
+            executor, channels, arguments->transport, arguments->wait_policy, PARENT_ID,
+            arguments->proc_n, getpid(), 0, arguments->use_lock
         );
     }
     debug_print(debug_proc_created_fmt, getpid());
 }
 
-void init(int proc_n, channel ***channels) {
+void *run_executor_thread(void *executor) {
+    run_worker(executor);
+    return NULL;
+}
+
+/**
+ * @brief      Initialize all executors running in this process (threads or coroutines).
+ *
+ * @param      arguments    The arguments
+ * @param      executors    The executors array (proc_n size)
+ * @param      channels     The channels matrix
+ * @param[in]  wait_policy  The wait policy
+ */
+void init_executors(
+    arguments *arguments, executor *executors, channel **channels, const wait_policy *wait_policy
+) {
+    pid_t pid = getpid();
+    for (int local_id = 0; local_id < arguments->proc_n; ++local_id) {
+        init_executor(
+            &executors[local_id], channels, arguments->transport, wait_policy, local_id,
+            arguments->proc_n, pid, local_id == PARENT_ID ? 0 : pid, arguments->use_lock
+        );
+    }
+}
+
+/**
+ * @brief      Run all executors as threads of this process: children in created threads, parent in
+ * the calling one. Executor code is the same as for processes, only the transport has to be
+ * thread safe.
+ *
+ * @param      arguments  The arguments
+ * @param      executors  The executors array (proc_n size)
+ * @param      channels   The channels matrix
+ */
+void run_threads(arguments *arguments, executor *executors, channel **channels) {
+    pthread_t threads[MAX_PROCESS_ID + 1];
+    init_executors(arguments, executors, channels, arguments->wait_policy);
+    for (int local_id = 1; local_id < arguments->proc_n; ++local_id) {
+        if (pthread_create(&threads[local_id], NULL, run_executor_thread, &executors[local_id])) {
+            perror("Failed to create executor thread");
+            exit(1);
+        }
+    }
+    run_worker(&executors[PARENT_ID]);
+    for (int local_id = 1; local_id < arguments->proc_n; ++local_id) {
+        pthread_join(threads[local_id], NULL);
+        cleanup_executor(&executors[local_id]);
+    }
+}
+
+/**
+ * @brief      Run all executors as coroutines of this thread. Executors yield to each other
+ * instead of blocking when they wait for messages (simulated transport yields itself, so its
+ * blocking waits are passed through).
+ *
+ * @param      arguments  The arguments
+ * @param      executors  The executors array (proc_n size)
+ * @param      channels   The channels matrix
+ */
+void run_executor_coroutines(arguments *arguments, executor *executors, channel **channels) {
+    const wait_policy *wait_policy
+        = arguments->transport->is_simulated ? &block_wait_policy : &yield_wait_policy;
+    init_executors(arguments, executors, channels, wait_policy);
+    if (run_coroutines(arguments->proc_n, executors) != 0) {
+        perror("Failed to run executor coroutines");
+        exit(1);
+    }
+    for (int local_id = 1; local_id < arguments->proc_n; ++local_id) {
+        cleanup_executor(&executors[local_id]);
+    }
+}
+
+void init(int proc_n, const transport *transport, channel ***channels) {
     *channels = malloc(proc_n * sizeof(channel *));
     for (int i = 0; i < proc_n; ++i) { (*channels)[i] = malloc(proc_n * sizeof(channel)); }
     debug_print(debug_malloc_ch_fin_fmt, (void *)*channels);
@@ -60,7 +141,7 @@ void init(int proc_n, channel ***channels) {
         perror("Failed to create channels");
         exit(1);
     }
-    if (open_channels(proc_n, *channels) != 0) {
+    if (transport->open(proc_n, *channels) != 0) {
         perror("Failed to open channels");
         exit(1);
     };
@@ -68,8 +149,8 @@ void init(int proc_n, channel ***channels) {
     open_events_log_f();
 }
 
-void cleanup(int proc_n, channel **channels, executor *executor) {
-    close_channels(proc_n, channels);
+void cleanup(int proc_n, const transport *transport, channel **channels, executor *executor) {
+    transport->close(proc_n, channels);
     cleanup_executor(executor);
     for (int i = 0; i < proc_n; ++i) free(channels[i]);
     free(channels);
@@ -93,7 +174,19 @@ int main(int argc, char **argv) {
     debug_print(debug_main_args_parsed_fmt, argc, arguments.proc_n);
 
     channel **channels;
-    init(arguments.proc_n, &channels);
+    set_tcp_nodes_path(arguments.nodes_path);
+    set_sim_options(arguments.sim_options);
+    init(arguments.proc_n, arguments.transport, &channels);
+
+    if (arguments.use_threads || arguments.use_coroutines) {
+        executor executors[MAX_PROCESS_ID + 1];
+        if (arguments.use_threads) run_threads(&arguments, executors, channels);
+        else run_executor_coroutines(&arguments, executors, channels);
+        cleanup(arguments.proc_n, arguments.transport, channels, &executors[PARENT_ID]);
+        debug_worker_print(debug_main_finish_fmt, PARENT_ID);
+        fflush(stdout);
+        return 0;
+    }
 
     executor executor;
     pid_t    parent_pid = getpid();
@@ -105,7 +198,9 @@ int main(int argc, char **argv) {
     if (is_parent(parent_pid)) {
         // wait all child processes
         while (wait(NULL) > 0) {}
-        cleanup(arguments.proc_n, channels, &executor);
+        cleanup(arguments.proc_n, arguments.transport, channels, &executor);
+    } else {
+        cleanup_executor(&executor);
     }
     debug_worker_print(debug_main_finish_fmt, executor.local_id);
     fflush(stdout);
@@ -0,0 +1,76 @@
+#include "msgpool.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ipc.h"
+
+static const uint16_t msg_pool_class_sizes[MSG_POOL_CLASS_N] = {16, 64, 256, 1024, MAX_MESSAGE_LEN};
+
+/**
+ * @brief      Gets the pool block of a message.
+ */
+PooledMsg *get_pooled_msg(Message *msg) {
+    return (PooledMsg *)((char *)msg - offsetof(PooledMsg, data));
+}
+
+void init_msg_pool(MsgPool *pool) {
+    memset(pool, 0, sizeof(MsgPool));
+}
+
+void destroy_msg_pool(MsgPool *pool) {
+    for (int i = 0; i < MSG_POOL_CLASS_N; ++i) {
+        while (pool->free[i] != NULL) {
+            PooledMsg *block = pool->free[i];
+            pool->free[i] = block->next;
+            free(block);
+        }
+    }
+    pool->is_closed = 1;
+}
+
+Message *alloc_msg(MsgPool *pool, uint16_t payload_len) {
+    uint32_t size = sizeof(MessageHeader) + payload_len;
+    uint8_t  size_class = 0;
+    if (payload_len > MAX_PAYLOAD_LEN) return NULL;
+    while (msg_pool_class_sizes[size_class] < size) size_class++;
+    PooledMsg *block = pool->free[size_class];
+    if (block != NULL) {
+        pool->free[size_class] = block->next;
+    } else {
+        block = malloc(sizeof(PooledMsg) + msg_pool_class_sizes[size_class]);
+        if (block == NULL) return NULL;
+        block->pool = pool;
+        block->size_class = size_class;
+        pool->malloc_n++;
+    }
+    block->next = NULL;
+    block->refs = 1;
+    pool->alloc_n++;
+    return (Message *)block->data;
+}
+
+Message *clone_msg(MsgPool *pool, const Message *msg) {
+    Message *copy = alloc_msg(pool, msg->s_header.s_payload_len);
+    if (copy == NULL) return NULL;
+    memcpy(copy, msg, sizeof(MessageHeader) + msg->s_header.s_payload_len);
+    return copy;
+}
+
+Message *hold_msg(Message *msg) {
+    get_pooled_msg(msg)->refs++;
+    return msg;
+}
+
+void release_msg(Message *msg) {
+    PooledMsg *block = get_pooled_msg(msg);
+    if (--block->refs > 0) return;
+    if (block->pool->is_closed) {
+        free(block);
+        return;
+    }
+    block->next = block->pool->free[block->size_class];
+    block->pool->free[block->size_class] = block;
+}
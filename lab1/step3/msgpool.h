@@ -0,0 +1,93 @@
+/**
+ * @file     msgpool.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Per-executor pool of variable-size reference-counted messages
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_MSGPOOL__H
+#define __ITMO_DISTRIBUTED_CLASS_MSGPOOL__H
+
+#include <stdint.h>
+
+#include "ipc.h"
+
+#define MSG_POOL_CLASS_N 5  // number of size classes (16, 64, 256, 1024 and MAX_MESSAGE_LEN bytes)
+
+struct MsgPool;
+
+/**
+ * Pool block: message of exactly class size bytes (header + payload) with its bookkeeping. Blocks
+ * are returned to the pool they are allocated from, even if the last holder is another executor
+ * of the same thread.
+ */
+typedef struct PooledMsg {
+    struct PooledMsg *next;        ///< Next free block of the same size class
+    struct MsgPool   *pool;        ///< Pool block belongs to
+    uint32_t          refs;        ///< Number of holders (0 for free block)
+    uint8_t           size_class;  ///< Size class index
+    char data[] __attribute__((aligned(sizeof(uint64_t))));  ///< Message (header + payload)
+} PooledMsg;
+
+/**
+ * Free lists of blocks by size class. Pool is not thread safe, so it is used only by its executor
+ * (and by coroutines of the same thread).
+ */
+typedef struct MsgPool {
+    PooledMsg *free[MSG_POOL_CLASS_N];  ///< Free blocks of every size class
+    uint32_t   alloc_n;                 ///< Number of allocated messages
+    uint32_t   malloc_n;                ///< Number of blocks allocated with malloc
+    uint8_t    is_closed;               ///< Pool is destroyed, released blocks are freed
+} MsgPool;
+
+/**
+ * @brief      Initializes an empty pool.
+ *
+ * @param      pool  The pool
+ */
+void init_msg_pool(MsgPool *pool);
+
+/**
+ * @brief      Frees free blocks of the pool. Messages still held are freed on the last release.
+ *
+ * @param      pool  The pool
+ */
+void destroy_msg_pool(MsgPool *pool);
+
+/**
+ * @brief      Allocates a message with room for exactly header and payload_len bytes (rounded up to
+ * the size class). Message is held once, payload bytes are not initialized.
+ *
+ * @param      pool         The pool
+ * @param[in]  payload_len  The payload length
+ *
+ * @return     The message, NULL on error
+ */
+Message *alloc_msg(MsgPool *pool, uint16_t payload_len);
+
+/**
+ * @brief      Copies a message (header + payload) into a new pool message.
+ *
+ * @param      pool  The pool
+ * @param[in]  msg   The message
+ *
+ * @return     The message, NULL on error
+ */
+Message *clone_msg(MsgPool *pool, const Message *msg);
+
+/**
+ * @brief      Adds a holder of pool message (e.g. one more destination of multicast message).
+ *
+ * @param      msg   The pool message
+ *
+ * @return     The same message
+ */
+Message *hold_msg(Message *msg);
+
+/**
+ * @brief      Removes a holder of pool message. The last release returns block to its pool.
+ *
+ * @param      msg   The pool message
+ */
+void release_msg(Message *msg);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_MSGPOOL__H
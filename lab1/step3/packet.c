@@ -0,0 +1,59 @@
+// MSG_DONTWAIT and MSG_NOSIGNAL are not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "packet.h"
+
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+int open_packet_pair(int fd[2]) {
+    return socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fd) != 0;
+}
+
+ssize_t send_packet(int fd, const void *buf, size_t size) {
+    // send is defined by ipc.h, so sendto is used
+    return sendto(fd, buf, size, MSG_DONTWAIT | MSG_NOSIGNAL, NULL, 0);
+}
+
+ssize_t recv_packet(int fd, void *buf, size_t size) {
+    return recv(fd, buf, size, MSG_DONTWAIT);
+}
+
+ssize_t send_packet_fd(int fd, const void *buf, size_t size, int passed_fd) {
+    char          control[CMSG_SPACE(sizeof(int))] = {0};
+    struct iovec  iov = {.iov_base = (void *)buf, .iov_len = size};
+    struct msghdr msg = {.msg_iov = &iov, .msg_iovlen = 1};
+    if (passed_fd >= 0) {
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &passed_fd, sizeof(int));
+    }
+    return sendmsg(fd, &msg, MSG_NOSIGNAL);
+}
+
+ssize_t recv_packet_fd(int fd, void *buf, size_t size, int *passed_fd) {
+    char          control[CMSG_SPACE(sizeof(int))];
+    struct iovec  iov = {.iov_base = buf, .iov_len = size};
+    struct msghdr msg = {
+        .msg_iov = &iov, .msg_iovlen = 1, .msg_control = control, .msg_controllen = sizeof(control)
+    };
+    ssize_t bytes = recvmsg(fd, &msg, MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+    *passed_fd = -1;
+    if (bytes <= 0) return bytes;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) continue;
+        memcpy(passed_fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+    return bytes;
+}
+
+int is_packet_closed(int fd) {
+    char byte;
+    return recv(fd, &byte, 1, MSG_PEEK | MSG_DONTWAIT) == 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file     packet.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Unix SOCK_SEQPACKET sockets calls (sys/socket.h send conflicts with ipc.h send, so
+ * sockets are used only through these functions and sys/socket.h is not included with ipc.h)
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_PACKET__H
+#define __ITMO_DISTRIBUTED_CLASS_PACKET__H
+
+#include <stddef.h>
+#include <sys/types.h>
+
+/**
+ * @brief      Opens a pair of connected SOCK_SEQPACKET sockets.
+ *
+ * @param      fd    The sockets handlers
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_packet_pair(int fd[2]);
+
+/**
+ * @brief      Sends one packet without waiting (SIGPIPE is not raised for closed socket).
+ *
+ * @param[in]  fd    The socket handler
+ * @param[in]  buf   The packet bytes
+ * @param[in]  size  The packet size
+ *
+ * @return     Number of sent bytes, -1 on error (errno is set)
+ */
+ssize_t send_packet(int fd, const void *buf, size_t size);
+
+/**
+ * @brief      Receives one packet without waiting.
+ *
+ * @param[in]  fd    The socket handler
+ * @param      buf   The buffer
+ * @param[in]  size  The buffer size
+ *
+ * @return     Number of received bytes, 0 if socket is closed by the other side, -1 on error or
+ * if there is no packet
+ */
+ssize_t recv_packet(int fd, void *buf, size_t size);
+
+/**
+ * @brief      Sends one packet with a file descriptor attached (SCM_RIGHTS). Waits while the socket
+ * send buffer is full.
+ *
+ * @param[in]  fd         The socket handler
+ * @param[in]  buf        The packet bytes
+ * @param[in]  size       The packet size
+ * @param[in]  passed_fd  The file descriptor to pass (-1 to send packet only)
+ *
+ * @return     Number of sent bytes, -1 on error (errno is set)
+ */
+ssize_t send_packet_fd(int fd, const void *buf, size_t size, int passed_fd);
+
+/**
+ * @brief      Receives one packet and a file descriptor attached to it without waiting.
+ *
+ * @param[in]  fd         The socket handler
+ * @param      buf        The buffer
+ * @param[in]  size       The buffer size
+ * @param      passed_fd  The received file descriptor (-1 if packet has no descriptor)
+ *
+ * @return     Number of received bytes, 0 if socket is closed by the other side, -1 on error or
+ * if there is no packet
+ */
+ssize_t recv_packet_fd(int fd, void *buf, size_t size, int *passed_fd);
+
+/**
+ * @brief      Determines if socket is closed by the other side and all packets are received.
+ *
+ * @param[in]  fd    The socket handler
+ *
+ * @return     1 if socket is closed, 0 otherwise
+ */
+int is_packet_closed(int fd);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_PACKET__H
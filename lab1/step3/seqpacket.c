@@ -0,0 +1,355 @@
+#include "seqpacket.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "packet.h"
+#include "transport.h"
+
+int open_seqpacket_channels(int16_t proc_n, channel **channels) {
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = 0; dst < proc_n; ++dst) {
+            channels[from][dst].read_h = -1;
+            channels[from][dst].write_h = -1;
+        }
+    }
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = from + 1; dst < proc_n; ++dst) {
+            int fd[2];
+            if (open_packet_pair(fd) != 0) return 1;
+            channels[from][dst].read_h = fd[0];
+            channels[dst][from].read_h = fd[1];
+            debug_print(debug_channel_open_fmt, from, dst, 0, fd[0], fd[1]);
+            log_pipes_msg(log_seqpacket_channel_opened_fmt, from, dst, fd[0], fd[1]);
+        }
+    }
+    return 0;
+}
+
+int close_unused_seqpacket_channels(int16_t proc_n, local_id local_id, channel **channels) {
+    // process uses only own sockets of pairs with other processes
+    for (int from = 0; from < proc_n; ++from) {
+        if (from == local_id) continue;
+        for (int dst = 0; dst < proc_n; ++dst) close_channel(channels, from, dst);
+    }
+    return 0;
+}
+
+/**
+ * @brief      Register socket of process id in the executor poll with events it has to be waited
+ * for: EPOLLIN while channel is active, EPOLLOUT while there are pending messages.
+ */
+void update_seqpacket_poll(executor *executor, local_id id) {
+    SeqpacketState    *state = executor->transport_state;
+    uint32_t           events = executor->poll_state[id] == POLL_ACTIVE ? EPOLLIN : 0;
+    struct epoll_event event = {.data.u32 = id};
+    int                op = 0;
+    if (state->pending[id].n > 0) events |= EPOLLOUT;
+    if (events == state->events[id]) return;
+    if (state->events[id] == 0) op = EPOLL_CTL_ADD;
+    else op = events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD;
+    event.events = events;
+    if (epoll_ctl(executor->poll_h, op, executor->ch_read[id], &event) != 0) return;
+    state->events[id] = events;
+}
+
+void set_executor_seqpacket_channels(int16_t proc_n, void *self, channel **channels) {
+    executor       *executor = self;
+    local_id        local_id = executor->local_id;
+    SeqpacketState *state = malloc(sizeof(SeqpacketState));
+    state->pending = calloc(proc_n, sizeof(PendingQueue));
+    state->backlog = calloc(proc_n, sizeof(PendingQueue));
+    state->events = calloc(proc_n, sizeof(uint32_t));
+    executor->transport_state = state;
+    executor->ch_read = malloc(proc_n * sizeof(channel_h));
+    executor->ch_write = malloc(proc_n * sizeof(channel_h));
+    executor->poll_n = 0;
+    executor->poll_h = epoll_create1(EPOLL_CLOEXEC);
+    if (executor->poll_h < 0) perror("Failed to init channels poll");
+
+    for (int other_id = 0; other_id < proc_n; ++other_id) {
+        executor->ch_read[other_id] = channels[local_id][other_id].read_h;
+        executor->ch_write[other_id] = channels[local_id][other_id].read_h;
+        executor->poll_state[other_id] = POLL_CLOSED;
+        if (other_id == local_id) continue;
+        executor->poll_state[other_id] = POLL_ACTIVE;
+        executor->poll_n++;
+        update_seqpacket_poll(executor, other_id);
+        debug_print(
+            debug_channel_set_fmt, local_id, 's', local_id, other_id, executor->ch_read[other_id]
+        );
+    }
+}
+
+/**
+ * @brief      Sends one frame to the process dst without waiting.
+ *
+ * @return     0 if frame is sent, 1 if socket send buffer is full, -1 on error
+ */
+int send_seqpacket_frame(executor *executor, local_id dst, const void *frame, uint32_t size) {
+    channel_h channel_h = get_channel_write_h(executor, dst);
+    ssize_t   bytes = send_packet(channel_h, frame, size);
+    if (bytes == (ssize_t)size) return 0;
+    if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 1;
+    return -1;
+}
+
+/**
+ * @brief      Send pending messages to the process dst until socket send buffer is full. Messages
+ * are dropped if they can not be delivered (e.g. the other process is finished).
+ *
+ * @return     0 if everything is sent, 1 if some messages are still pending
+ */
+int flush_seqpacket_pending(void *self, local_id dst) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    PendingQueue   *pending = &state->pending[dst];
+    while (pending->head != NULL) {
+        int rc = send_seqpacket_frame(executor, dst, pending->head->data, pending->head->size);
+        if (rc > 0) break;
+        pop_pending(pending);
+    }
+    update_seqpacket_poll(executor, dst);
+    return pending->n > 0;
+}
+
+/**
+ * @brief      Drop pending messages for the process dst (the other process is finished).
+ */
+void drop_seqpacket_pending(void *self, local_id dst) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    while (state->pending[dst].head != NULL) pop_pending(&state->pending[dst]);
+    update_seqpacket_poll(executor, dst);
+}
+
+/**
+ * @brief      Receive all available messages from the process from into backlog.
+ *
+ * @return     0 on success, -1 if the other process is finished
+ */
+int drain_seqpacket_channel(void *self, local_id from) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    Message         msg;
+    ssize_t         bytes = 0;
+    while ((bytes = recv_packet(get_channel_read_h(executor, from), &msg, sizeof(Message))) > 0) {
+        // message is skipped if there is no memory for it, like inbox backend does
+        push_pending(&state->backlog[from], &msg, bytes);
+    }
+    return bytes == 0 || (errno != EAGAIN && errno != EWOULDBLOCK) ? -1 : 0;
+}
+
+const PendingWaitOps seqpacket_wait_ops = {
+    .flush = flush_seqpacket_pending,
+    .drop = drop_seqpacket_pending,
+    .drain = drain_seqpacket_channel,
+};
+
+int flush_seqpacket_channels(void *self) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    int             rc = 0;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (state->pending[dst].n == 0) continue;
+        rc |= flush_seqpacket_pending(executor, dst);
+    }
+    return rc;
+}
+
+int write_seqpacket_channel(void *self, local_id dst, const Message *msg) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    PendingQueue   *pending = &state->pending[dst];
+    uint32_t        msg_size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    int             rc = 0;
+    if (pending->n > 0) {
+        // keep order: message goes after already pending ones
+        rc = push_pending(pending, msg, msg_size);
+        flush_seqpacket_pending(executor, dst);
+    } else {
+        int sent = send_seqpacket_frame(executor, dst, msg, msg_size);
+        if (sent > 0) {
+            rc = push_pending(pending, msg, msg_size);
+            update_seqpacket_poll(executor, dst);
+        }
+        // the other process is finished, message is dropped like pipes backend does
+        if (sent < 0 && errno != EPIPE && errno != ECONNRESET) rc = 1;
+    }
+    if (pending->bytes >= PENDING_HIGH_WATER) {
+        pending->waits_n++;
+        debug_ipc_print(debug_channel_high_water_fmt, executor->local_id, dst, pending->bytes);
+        wait_pending_writable(executor, dst, pending, PENDING_HIGH_WATER, &seqpacket_wait_ops);
+    }
+    return rc;
+}
+
+int read_seqpacket_channel(void *self, local_id from, Message *msg) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    PendingFrame   *frame = state->backlog[from].head;
+    if (frame != NULL) {
+        memcpy(msg, frame->data, frame->size);
+        pop_pending(&state->backlog[from]);
+        return 0;
+    }
+    ssize_t bytes = recv_packet(get_channel_read_h(executor, from), msg, sizeof(Message));
+    if (bytes < (ssize_t)sizeof(MessageHeader)) return -1;
+    return bytes == (ssize_t)(sizeof(MessageHeader) + msg->s_header.s_payload_len) ? 0 : -1;
+}
+
+/**
+ * @brief      Mark channel from the process from as closed and stop waiting for it.
+ */
+void close_seqpacket_poll(executor *executor, local_id from) {
+    if (executor->poll_state[from] == POLL_ACTIVE) executor->poll_n--;
+    executor->poll_state[from] = POLL_CLOSED;
+    update_seqpacket_poll(executor, from);
+}
+
+/**
+ * @brief      Collect channels which have messages in backlog and not masked.
+ *
+ * @return     Number of ready channels
+ */
+int get_seqpacket_backlog_ready(executor *executor, local_id *ready) {
+    SeqpacketState *state = executor->transport_state;
+    int             ready_n = 0;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (executor->poll_state[from] == POLL_MASKED) continue;
+        if (state->backlog[from].head != NULL) ready[ready_n++] = from;
+    }
+    return ready_n;
+}
+
+int wait_seqpacket_ready(void *self, local_id *ready, int timeout) {
+    executor          *executor = self;
+    SeqpacketState    *state = executor->transport_state;
+    struct epoll_event events[MAX_PROCESS_ID + 1];
+    // messages received into backlog are not visible for epoll
+    int                ready_n = get_seqpacket_backlog_ready(executor, ready);
+    int                backlog_n = ready_n;
+    do {
+        if (executor->poll_n == 0) return ready_n > 0 ? ready_n : -1;
+        int events_n
+            = epoll_wait(executor->poll_h, events, executor->proc_n, ready_n > 0 ? 0 : timeout);
+        if (events_n < 0 && errno == EINTR) continue;
+        if (events_n < 0) return -1;
+        if (events_n == 0) return ready_n;
+        for (int i = 0; i < events_n; ++i) {
+            local_id id = events[i].data.u32;
+            if (events[i].events & (EPOLLOUT | EPOLLERR) && state->pending[id].n > 0) {
+                flush_seqpacket_pending(executor, id);
+            }
+            if (executor->poll_state[id] != POLL_ACTIVE) continue;
+            if (!(events[i].events & (EPOLLIN | EPOLLHUP))) continue;
+            // socket of finished process stays readable, but there is nothing to read anymore
+            channel_h channel_h = get_channel_read_h(executor, id);
+            if (events[i].events & EPOLLHUP && is_packet_closed(channel_h)) {
+                close_seqpacket_poll(executor, id);
+                continue;
+            }
+            int is_backlog = 0;
+            for (int j = 0; j < backlog_n; ++j) is_backlog |= ready[j] == id;
+            if (!is_backlog) ready[ready_n++] = id;
+        }
+    } while (ready_n == 0);
+    return ready_n;
+}
+
+int wait_seqpacket_one_ready(void *self, local_id from, int timeout) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    struct pollfd   pfds[MAX_PROCESS_ID + 1];
+    local_id        ids[MAX_PROCESS_ID + 1];
+    if (state->backlog[from].head != NULL) return 1;
+    while (1) {
+        // sockets with pending messages are waited too, so the other process is not blocked
+        int pfds_n = 1;
+        pfds[0].fd = get_channel_read_h(executor, from);
+        pfds[0].events = POLLIN;
+        ids[0] = from;
+        for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+            if (state->pending[dst].n == 0) continue;
+            if (dst == from) {
+                pfds[0].events |= POLLOUT;
+                continue;
+            }
+            pfds[pfds_n].fd = get_channel_write_h(executor, dst);
+            pfds[pfds_n].events = POLLOUT;
+            ids[pfds_n++] = dst;
+        }
+        int rc = poll(pfds, pfds_n, timeout);
+        if (rc < 0 && errno == EINTR) continue;
+        if (rc <= 0) return rc;
+        for (int i = 0; i < pfds_n; ++i) {
+            if (pfds[i].revents & (POLLOUT | POLLERR)) flush_seqpacket_pending(executor, ids[i]);
+        }
+        if (!(pfds[0].revents & (POLLIN | POLLHUP))) continue;
+        return pfds[0].revents & POLLHUP && is_packet_closed(pfds[0].fd) ? -1 : 1;
+    }
+}
+
+void mask_seqpacket_poll(void *self, local_id from) {
+    executor *executor = self;
+    mask_poll_state(executor, from);
+    update_seqpacket_poll(executor, from);
+}
+
+void unmask_seqpacket_poll(void *self) {
+    executor *executor = self;
+    unmask_poll_state(executor);
+    for (local_id from = 0; from < executor->proc_n; ++from) update_seqpacket_poll(executor, from);
+}
+
+void cleanup_executor_seqpacket_channels(void *self) {
+    executor       *executor = self;
+    SeqpacketState *state = executor->transport_state;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst == executor->local_id) continue;
+        PendingQueue *pending = &state->pending[dst];
+        // messages must be delivered before exit (unless the other process is finished)
+        wait_pending_writable(executor, dst, pending, 0, &seqpacket_wait_ops);
+        if (pending->total_n == 0) continue;
+        debug_ipc_print(
+            debug_channel_pending_stats_fmt, executor->local_id, dst, pending->total_n,
+            pending->max_n, pending->waits_n
+        );
+    }
+    close_channels_poll(executor);
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        while (state->backlog[from].head != NULL) pop_pending(&state->backlog[from]);
+    }
+    free(state->pending);
+    free(state->backlog);
+    free(state->events);
+    free(state);
+    free(executor->ch_read);
+    free(executor->ch_write);
+}
+
+const transport seqpacket_transport = {
+    .name = "seqpacket",
+    .open = open_seqpacket_channels,
+    .set_executor = set_executor_seqpacket_channels,
+    .close_unused = close_unused_seqpacket_channels,
+    .close = close_channels,
+    .cleanup = cleanup_executor_seqpacket_channels,
+    .flush = flush_seqpacket_channels,
+    .write = write_seqpacket_channel,
+    .read = read_seqpacket_channel,
+    .wait_ready = wait_seqpacket_ready,
+    .wait_one_ready = wait_seqpacket_one_ready,
+    .mask = mask_seqpacket_poll,
+    .unmask = unmask_seqpacket_poll,
+};
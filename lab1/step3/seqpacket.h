@@ -0,0 +1,70 @@
+/**
+ * @file     seqpacket.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Unix sockets transport: one SOCK_SEQPACKET socket pair per pair of processes
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_SEQPACKET__H
+#define __ITMO_DISTRIBUTED_CLASS_SEQPACKET__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+/**
+ * Sockets backend executor state. Every message is one packet, so there is nothing to buffer on
+ * read. Messages which do not fit into the socket send buffer are kept in pending queues, messages
+ * received while sender waits for them to be sent are kept in backlog.
+ */
+typedef struct {
+    PendingQueue *pending;  ///< Messages not sent yet (indexed by destination local id)
+    PendingQueue *backlog;  ///< Messages received while waiting (indexed by source local id)
+    uint32_t     *events;   ///< Events socket is registered in poll with (indexed by local id)
+} SeqpacketState;
+
+/**
+ * @brief      Opens a socket pair for every pair of processes. Both sockets are stored in the
+ * channels matrix as read handlers: channels[a][b].read_h is the socket of process a connected to
+ * process b (write handlers are not used and set to -1).
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_seqpacket_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sets the executor sockets (the same socket is used to read and write).
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      executor  The executor
+ * @param      channels  The channels matrix
+ */
+void set_executor_seqpacket_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Sends a message to the process dst with one packet. If the socket send buffer is
+ * full, message is kept in the pending queue and sent when the socket becomes writable.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int write_seqpacket_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Receives a message from the process from with one call.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no message or on error
+ */
+int read_seqpacket_channel(void *executor, local_id from, Message *msg);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_SEQPACKET__H
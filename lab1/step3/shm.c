@@ -0,0 +1,565 @@
+// MAP_ANONYMOUS is not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "shm.h"
+
+#include <linux/futex.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "coroutine.h"
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "transport.h"
+#include "util.h"
+
+// shared by processes region: rings matrix (row - src, col - dst), broadcast rings (indexed by
+// writer local id), cursors matrix (row - writer, col - reader), doorbells (indexed by local id)
+static ShmRing          *shm_rings = NULL;
+static ShmBroadcastRing *shm_broadcasts = NULL;
+static ShmCursor        *shm_cursors = NULL;
+static ShmDoorbell      *shm_doorbells = NULL;
+static int16_t           shm_proc_n = 0;
+static uint32_t          shm_ring_size = SHM_RING_SIZE;
+
+/**
+ * @brief      Gets the size of shared memory region with rings of ring_size bytes.
+ */
+size_t get_shm_sized_region_size(int16_t proc_n, uint32_t ring_size) {
+    return (sizeof(ShmRing) + ring_size + sizeof(ShmCursor)) * proc_n * proc_n
+         + (sizeof(ShmBroadcastRing) + sizeof(ShmDoorbell)) * proc_n;
+}
+
+uint32_t get_shm_ring_size(int16_t proc_n) {
+    uint32_t ring_size = SHM_RING_SIZE;
+    while (ring_size > SHM_MIN_RING_SIZE
+           && get_shm_sized_region_size(proc_n, ring_size) > SHM_REGION_LIMIT) {
+        ring_size /= 2;
+    }
+    return ring_size;
+}
+
+size_t get_shm_region_size(int16_t proc_n) {
+    return get_shm_sized_region_size(proc_n, get_shm_ring_size(proc_n));
+}
+
+int is_shm_proc_n_supported(int16_t proc_n) {
+    return get_shm_region_size(proc_n) <= SHM_REGION_LIMIT;
+}
+
+/**
+ * @brief      Gets the ring for channel from -> dst.
+ *
+ * @param[in]  from  The from process local id
+ * @param[in]  dst   The destination process local id
+ *
+ * @return     The ring pointer.
+ */
+ShmRing *get_shm_ring(local_id from, local_id dst) {
+    size_t stride = sizeof(ShmRing) + shm_ring_size;
+    return (ShmRing *)((char *)shm_rings + (from * shm_proc_n + dst) * stride);
+}
+
+/**
+ * @brief      Gets the broadcast ring of process.
+ *
+ * @param[in]  from  The writer process local id
+ *
+ * @return     The broadcast ring pointer.
+ */
+ShmBroadcastRing *get_shm_broadcast(local_id from) {
+    return &shm_broadcasts[from];
+}
+
+/**
+ * @brief      Gets the cursor of reader dst in the broadcast ring of writer from.
+ *
+ * @param[in]  from  The writer process local id
+ * @param[in]  dst   The reader process local id
+ *
+ * @return     The cursor pointer.
+ */
+ShmCursor *get_shm_cursor(local_id from, local_id dst) {
+    return &shm_cursors[from * shm_proc_n + dst];
+}
+
+/**
+ * @brief      Gets the doorbell of process inbound rings.
+ *
+ * @param[in]  id    The process local id
+ *
+ * @return     The doorbell pointer.
+ */
+ShmDoorbell *get_shm_doorbell(local_id id) {
+    return &shm_doorbells[id];
+}
+
+int open_shm_channels(int16_t proc_n, channel **channels) {
+    size_t size = get_shm_region_size(proc_n);
+    void  *region = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) return 1;
+    // anonymous mapping is zero filled, so all rings are empty
+    shm_ring_size = get_shm_ring_size(proc_n);
+    shm_rings = region;
+    size_t rings_size = (sizeof(ShmRing) + shm_ring_size) * proc_n * proc_n;
+    shm_broadcasts = (ShmBroadcastRing *)((char *)region + rings_size);
+    shm_cursors = (ShmCursor *)(shm_broadcasts + proc_n);
+    shm_doorbells = (ShmDoorbell *)(shm_cursors + proc_n * proc_n);
+    shm_proc_n = proc_n;
+    debug_print(debug_shm_open_fmt, proc_n, size, region);
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = 0; dst < proc_n; ++dst) {
+            if (from == dst) continue;
+            log_pipes_msg(log_shm_channel_opened_fmt, from, dst, shm_ring_size);
+        }
+    }
+    return 0;
+}
+
+void set_executor_shm_channels(int16_t proc_n, void *self, channel **channels) {
+    executor *executor = self;
+    ShmState *state = malloc(sizeof(ShmState));
+    state->multicast_sent_n = 0;
+    state->doorbell_sleep_n = 0;
+    state->doorbell_wake_n = 0;
+    state->space_wait_n = 0;
+    state->multicast_read_n = calloc(proc_n, sizeof(uint32_t));
+    state->backlog = calloc(proc_n, sizeof(PendingQueue));
+    state->borrowed_from = -1;
+    state->is_backlog_borrowed = 0;
+    executor->transport_state = state;
+    executor->ch_read = NULL;
+    executor->ch_write = NULL;
+    executor->poll_h = -1;
+    executor->poll_n = 0;
+    for (local_id from = 0; from < proc_n; ++from) {
+        executor->poll_state[from] = from == executor->local_id ? POLL_CLOSED : POLL_ACTIVE;
+        executor->poll_n += from != executor->local_id;
+    }
+}
+
+int close_shm_unused_channels(int16_t proc_n, local_id local_id, channel **channels) {
+    // every process has to see the whole region, nothing to close
+    return 0;
+}
+
+int close_shm_channels(int16_t proc_n, channel **channels) {
+    if (shm_rings == NULL) return 0;
+    int rc = munmap(shm_rings, get_shm_region_size(proc_n));
+    shm_rings = NULL;
+    shm_broadcasts = NULL;
+    shm_cursors = NULL;
+    shm_doorbells = NULL;
+    for (local_id from = 0; from < proc_n; ++from) {
+        for (local_id dst = 0; dst < proc_n; ++dst) {
+            if (from == dst) continue;
+            log_pipes_msg(log_channel_closed_fmt, from, dst);
+        }
+    }
+    return rc;
+}
+
+/**
+ * @brief      Copy data into ring buffer of size (power of two) starting from position (with wrap
+ * around).
+ */
+void ring_copy_in(char *buffer, uint32_t size, uint32_t pos, const void *src, size_t len) {
+    uint32_t offset = pos & (size - 1);
+    size_t   first = min_v(len, size - offset);
+    memcpy(buffer + offset, src, first);
+    memcpy(buffer, (const char *)src + first, len - first);
+}
+
+/**
+ * @brief      Copy data from ring buffer of size (power of two) starting from position (with wrap
+ * around).
+ */
+void ring_copy_out(const char *buffer, uint32_t size, uint32_t pos, void *dst, size_t len) {
+    uint32_t offset = pos & (size - 1);
+    size_t   first = min_v(len, size - offset);
+    memcpy(dst, buffer + offset, first);
+    memcpy((char *)dst + first, buffer, len - first);
+}
+
+/**
+ * @brief      Copy a message from ring buffer starting from position.
+ *
+ * @return     The message size
+ */
+uint32_t ring_copy_msg_out(const char *buffer, uint32_t size, uint32_t pos, Message *msg) {
+    ring_copy_out(buffer, size, pos, &(msg->s_header), sizeof(MessageHeader));
+    ring_copy_out(
+        buffer, size, pos + sizeof(MessageHeader), msg->s_payload, msg->s_header.s_payload_len
+    );
+    return sizeof(MessageHeader) + msg->s_header.s_payload_len;
+}
+
+/**
+ * @brief      Notify process about published message (wake it if it sleeps on the doorbell).
+ */
+void ring_shm_doorbell(ShmState *state, local_id id) {
+    ShmDoorbell *doorbell = get_shm_doorbell(id);
+    // seq is changed before waiters are checked, receiver does it in reverse order
+    __atomic_add_fetch(&doorbell->seq, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&doorbell->waiters, __ATOMIC_SEQ_CST) == 0) return;
+    syscall(SYS_futex, &doorbell->seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+    state->doorbell_wake_n++;
+}
+
+/**
+ * @brief      Sleep on own doorbell until a message is published after seq was read (or timeout
+ * in ms is expired, POLL_BLOCK to sleep without timeout).
+ */
+void wait_shm_doorbell(ShmState *state, local_id id, uint32_t seq, int timeout) {
+    ShmDoorbell    *doorbell = get_shm_doorbell(id);
+    struct timespec limit = {.tv_sec = timeout / 1000, .tv_nsec = (timeout % 1000) * 1000000L};
+    __atomic_add_fetch(&doorbell->waiters, 1, __ATOMIC_SEQ_CST);
+    // returns at once if seq is changed already (shared mapping, so futex is not private)
+    syscall(SYS_futex, &doorbell->seq, FUTEX_WAIT, seq, timeout > 0 ? &limit : NULL, NULL, 0);
+    __atomic_sub_fetch(&doorbell->waiters, 1, __ATOMIC_SEQ_CST);
+    state->doorbell_sleep_n++;
+}
+
+/**
+ * @brief      Reads own doorbell seq (before checking rings).
+ */
+uint32_t get_shm_doorbell_seq(local_id id) {
+    return __atomic_load_n(&get_shm_doorbell(id)->seq, __ATOMIC_SEQ_CST);
+}
+
+/**
+ * @brief      Notify writer about freed slot of its ring (wake it if it waits for space). Writer
+ * waits on its message doorbell, so a message sent to it wakes it as well.
+ */
+void ring_shm_space_doorbell(local_id id) {
+    ShmDoorbell *doorbell = get_shm_doorbell(id);
+    // freed position is stored before the mark is checked, writer does it in reverse order
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&doorbell->space_waiters, __ATOMIC_SEQ_CST) == 0) return;
+    __atomic_add_fetch(&doorbell->seq, 1, __ATOMIC_SEQ_CST);
+    syscall(SYS_futex, &doorbell->seq, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/**
+ * @brief      Determines if backlog or rings of process from have messages for executor to read.
+ */
+int is_shm_channel_ready(executor *executor, local_id from) {
+    ShmState *state = executor->transport_state;
+    local_id  dst = executor->local_id;
+    if (state->backlog[from].head != NULL) return 1;
+    ShmRing *ring = get_shm_ring(from, dst);
+    if (__atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) != ring->head) return 1;
+    uint32_t tail = __atomic_load_n(&get_shm_broadcast(from)->tail, __ATOMIC_ACQUIRE);
+    return tail != get_shm_cursor(from, dst)->head;
+}
+
+/**
+ * @brief      Gets the size of the message in ring buffer starting from position.
+ */
+uint32_t get_ring_msg_size(const char *buffer, uint32_t size, uint32_t pos) {
+    MessageHeader header;
+    ring_copy_out(buffer, size, pos, &header, sizeof(MessageHeader));
+    return sizeof(MessageHeader) + header.s_payload_len;
+}
+
+/**
+ * @brief      Find the next message sent by process from (in the ring from -> self or in the
+ * broadcast ring of process from).
+ *
+ * @return     0 if message is found, -1 if rings are empty
+ */
+int peek_shm_slot(executor *executor, local_id from, ShmSlot *slot) {
+    ShmState         *state = executor->transport_state;
+    ShmRing          *ring = get_shm_ring(from, executor->local_id);
+    ShmBroadcastRing *broadcast = get_shm_broadcast(from);
+    ShmCursor        *cursor = get_shm_cursor(from, executor->local_id);
+    uint32_t          head = ring->head;
+    uint32_t          broadcast_tail = __atomic_load_n(&broadcast->tail, __ATOMIC_ACQUIRE);
+    uint32_t          tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if (tail != head) {
+        uint32_t multicast_n = 0;
+        ring_copy_out(ring->buffer, shm_ring_size, head, &multicast_n, sizeof(multicast_n));
+        if (multicast_n == state->multicast_read_n[from]) {
+            slot->buffer = ring->buffer;
+            slot->buffer_size = shm_ring_size;
+            slot->pos = head + sizeof(multicast_n);
+            slot->size = sizeof(multicast_n)
+                       + get_ring_msg_size(slot->buffer, shm_ring_size, slot->pos);
+            slot->is_broadcast = 0;
+            return 0;
+        }
+        // multicast messages sent before this one are published before it
+        broadcast_tail = __atomic_load_n(&broadcast->tail, __ATOMIC_ACQUIRE);
+    }
+    if (broadcast_tail == cursor->head) return -1;
+    slot->buffer = broadcast->buffer;
+    slot->buffer_size = SHM_BROADCAST_SIZE;
+    slot->pos = cursor->head;
+    slot->size = get_ring_msg_size(slot->buffer, SHM_BROADCAST_SIZE, slot->pos);
+    slot->is_broadcast = 1;
+    return 0;
+}
+
+/**
+ * @brief      Move reader position past the slot, so producer can reuse it.
+ */
+void consume_shm_slot(executor *executor, local_id from, const ShmSlot *slot) {
+    ShmState *state = executor->transport_state;
+    if (slot->is_broadcast) {
+        ShmCursor *cursor = get_shm_cursor(from, executor->local_id);
+        __atomic_store_n(&cursor->head, cursor->head + slot->size, __ATOMIC_RELEASE);
+        state->multicast_read_n[from]++;
+    } else {
+        ShmRing *ring = get_shm_ring(from, executor->local_id);
+        __atomic_store_n(&ring->head, ring->head + slot->size, __ATOMIC_RELEASE);
+    }
+    ring_shm_space_doorbell(from);
+}
+
+/**
+ * @brief      Gets free bytes of executor broadcast ring (slot is free only when the slowest reader
+ * passed it).
+ */
+uint32_t get_shm_broadcast_free(executor *executor) {
+    uint32_t tail = get_shm_broadcast(executor->local_id)->tail;
+    uint32_t used = 0;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst == executor->local_id) continue;
+        ShmCursor *cursor = get_shm_cursor(executor->local_id, dst);
+        uint32_t   head = __atomic_load_n(&cursor->head, __ATOMIC_ACQUIRE);
+        used = max_v(used, tail - head);
+    }
+    return SHM_BROADCAST_SIZE - used;
+}
+
+/**
+ * @brief      Gets free bytes of executor ring to dst (SHM_BROADCAST for the broadcast ring).
+ */
+uint32_t get_shm_free(executor *executor, local_id dst) {
+    if (dst == SHM_BROADCAST) return get_shm_broadcast_free(executor);
+    ShmRing *ring = get_shm_ring(executor->local_id, dst);
+    return shm_ring_size - (ring->tail - __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE));
+}
+
+/**
+ * @brief      Move all messages of inbound rings into the executor backlog, so their writers can
+ * go on. Ring of the borrowed message is skipped, its slot has to stay in place.
+ *
+ * @return     The number of moved messages
+ */
+int drain_shm_inbound(executor *executor) {
+    ShmState *state = executor->transport_state;
+    Message  *msg = &state->drained;
+    ShmSlot   slot;
+    int       moved_n = 0;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (from == executor->local_id || from == state->borrowed_from) continue;
+        while (peek_shm_slot(executor, from, &slot) == 0) {
+            uint32_t size = ring_copy_msg_out(slot.buffer, slot.buffer_size, slot.pos, msg);
+            // message stays in the ring if there is no memory for its copy
+            if (push_pending(&state->backlog[from], msg, size) != 0) break;
+            consume_shm_slot(executor, from, &slot);
+            moved_n++;
+        }
+    }
+    return moved_n;
+}
+
+/**
+ * @brief      Wait until own ring to dst (SHM_BROADCAST for the broadcast ring) has size free
+ * bytes. Inbound rings are drained meanwhile, since their writers may wait for this executor.
+ * Coroutines of one thread yield to readers, otherwise writer spins for a while and then sleeps on
+ * own doorbell with space waiters mark, so both freed slot and new message wake it.
+ */
+void wait_shm_space(executor *executor, local_id dst, uint32_t size) {
+    ShmState    *state = executor->transport_state;
+    ShmDoorbell *doorbell = get_shm_doorbell(executor->local_id);
+    uint32_t     spin_n = 0;
+    if (get_shm_free(executor, dst) >= size) return;
+    state->space_wait_n++;
+    while (1) {
+        drain_shm_inbound(executor);
+        if (get_shm_free(executor, dst) >= size) return;
+        if (get_live_coroutines_n() > 0) {
+            yield_coroutine();
+            continue;
+        }
+        if (spin_n++ < SHM_SPACE_SPIN_N) {
+            sched_yield();
+            continue;
+        }
+        // mark is set before seq is read, reader checks it after freeing slot
+        __atomic_add_fetch(&doorbell->space_waiters, 1, __ATOMIC_SEQ_CST);
+        uint32_t seq = get_shm_doorbell_seq(executor->local_id);
+        if (drain_shm_inbound(executor) == 0 && get_shm_free(executor, dst) < size) {
+            syscall(SYS_futex, &doorbell->seq, FUTEX_WAIT, seq, NULL, NULL, 0);
+            state->doorbell_sleep_n++;
+        }
+        __atomic_sub_fetch(&doorbell->space_waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+int write_shm_channel(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    ShmState *state = executor->transport_state;
+    ShmRing  *ring = get_shm_ring(executor->local_id, dst);
+    uint32_t  multicast_n = state->multicast_sent_n;
+    uint32_t  msg_size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    uint32_t  size = sizeof(multicast_n) + msg_size;
+    uint32_t  tail = ring->tail;
+    if (size > shm_ring_size) return 1;
+    // message is never dropped, reader frees the ring when it receives
+    wait_shm_space(executor, dst, size);
+    ring_copy_in(ring->buffer, shm_ring_size, tail, &multicast_n, sizeof(multicast_n));
+    ring_copy_in(ring->buffer, shm_ring_size, tail + sizeof(multicast_n), msg, msg_size);
+    // publish message only after its bytes are written
+    __atomic_store_n(&ring->tail, tail + size, __ATOMIC_RELEASE);
+    ring_shm_doorbell(state, dst);
+    return 0;
+}
+
+int multicast_shm_channel(void *self, const Message *msg) {
+    executor         *executor = self;
+    ShmState         *state = executor->transport_state;
+    ShmBroadcastRing *ring = get_shm_broadcast(executor->local_id);
+    uint32_t          size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    uint32_t          tail = ring->tail;
+    if (size > SHM_BROADCAST_SIZE) return 1;
+    // message is written once, so it waits for the slowest reader instead of being dropped
+    wait_shm_space(executor, SHM_BROADCAST, size);
+    ring_copy_in(ring->buffer, SHM_BROADCAST_SIZE, tail, msg, size);
+    __atomic_store_n(&ring->tail, tail + size, __ATOMIC_RELEASE);
+    state->multicast_sent_n++;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        if (dst != executor->local_id) ring_shm_doorbell(state, dst);
+    }
+    return 0;
+}
+
+int read_shm_channel(void *self, local_id from, Message *msg) {
+    executor     *executor = self;
+    ShmState     *state = executor->transport_state;
+    PendingFrame *frame = state->backlog[from].head;
+    ShmSlot       slot;
+    if (frame != NULL) {
+        memcpy(msg, frame->data, frame->size);
+        pop_pending(&state->backlog[from]);
+        return 0;
+    }
+    if (peek_shm_slot(executor, from, &slot) != 0) return -1;
+    ring_copy_msg_out(slot.buffer, slot.buffer_size, slot.pos, msg);
+    // release slot for producer only after message bytes are copied out
+    consume_shm_slot(executor, from, &slot);
+    return 0;
+}
+
+const Message *borrow_shm_channel(void *self, local_id from) {
+    executor *executor = self;
+    ShmState *state = executor->transport_state;
+    ShmSlot  *slot = &state->borrowed;
+    if (state->backlog[from].head != NULL) {
+        PendingFrame *frame = state->backlog[from].head;
+        state->is_backlog_borrowed = 1;
+        if (is_message_aligned(frame->data)) return (const Message *)frame->data;
+        memcpy(executor->borrowed, frame->data, frame->size);
+        return executor->borrowed;
+    }
+    if (peek_shm_slot(executor, from, slot) != 0) return NULL;
+    // writer of the slot is not drained until the slot is released
+    state->borrowed_from = from;
+    uint32_t    offset = slot->pos & (slot->buffer_size - 1);
+    uint32_t    msg_size = get_ring_msg_size(slot->buffer, slot->buffer_size, slot->pos);
+    const char *data = slot->buffer + offset;
+    if (offset + msg_size <= slot->buffer_size && is_message_aligned(data)) {
+        return (const Message *)data;
+    }
+    ring_copy_msg_out(slot->buffer, slot->buffer_size, slot->pos, executor->borrowed);
+    return executor->borrowed;
+}
+
+void release_shm_channel(void *self, local_id from) {
+    executor *executor = self;
+    ShmState *state = executor->transport_state;
+    if (state->is_backlog_borrowed) {
+        pop_pending(&state->backlog[from]);
+        state->is_backlog_borrowed = 0;
+        return;
+    }
+    consume_shm_slot(executor, from, &state->borrowed);
+    state->borrowed_from = -1;
+}
+
+int wait_shm_ready(void *self, local_id *ready, int timeout) {
+    executor *executor = self;
+    int       is_waited = 0;
+    if (executor->poll_n == 0) return -1;
+    while (1) {
+        uint32_t seq = get_shm_doorbell_seq(executor->local_id);
+        int      ready_n = 0;
+        for (local_id from = 0; from < executor->proc_n; ++from) {
+            if (executor->poll_state[from] != POLL_ACTIVE) continue;
+            if (is_shm_channel_ready(executor, from)) ready[ready_n++] = from;
+        }
+        if (ready_n > 0 || timeout == POLL_NOWAIT) return ready_n;
+        if (timeout > 0 && is_waited) return 0;
+        wait_shm_doorbell(executor->transport_state, executor->local_id, seq, timeout);
+        is_waited = 1;
+    }
+}
+
+int wait_shm_one_ready(void *self, local_id from, int timeout) {
+    executor *executor = self;
+    int       is_waited = 0;
+    while (1) {
+        uint32_t seq = get_shm_doorbell_seq(executor->local_id);
+        if (is_shm_channel_ready(executor, from)) return 1;
+        if (timeout == POLL_NOWAIT || (timeout > 0 && is_waited)) return 0;
+        // doorbell is shared by all inbound rings, so other senders can wake it too
+        wait_shm_doorbell(executor->transport_state, executor->local_id, seq, timeout);
+        is_waited = 1;
+    }
+}
+
+void cleanup_shm_executor(void *self) {
+    executor *executor = self;
+    ShmState *state = executor->transport_state;
+    // region is unmapped by close_shm_channels
+    debug_ipc_print(
+        debug_shm_doorbell_stats_fmt, executor->local_id, state->doorbell_sleep_n,
+        state->doorbell_wake_n, state->space_wait_n
+    );
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        while (state->backlog[from].head != NULL) pop_pending(&state->backlog[from]);
+    }
+    free(state->multicast_read_n);
+    free(state->backlog);
+    free(state);
+}
+
+const transport shm_transport = {
+    .name = "shm",
+    .is_thread_safe = 1,
+    .open = open_shm_channels,
+    .set_executor = set_executor_shm_channels,
+    .close_unused = close_shm_unused_channels,
+    .close = close_shm_channels,
+    .cleanup = cleanup_shm_executor,
+    .write = write_shm_channel,
+    .multicast = multicast_shm_channel,
+    .read = read_shm_channel,
+    .borrow = borrow_shm_channel,
+    .release = release_shm_channel,
+    .wait_ready = wait_shm_ready,
+    .wait_one_ready = wait_shm_one_ready,
+    .mask = mask_poll_state,
+    .unmask = unmask_poll_state,
+};
@@ -0,0 +1,211 @@
+/**
+ * @file     shm.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Shared memory transport: lock-free SPSC ring per directed pair of processes,
+ * broadcast ring per process for multicast and futex doorbell per process
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_SHM__H
+#define __ITMO_DISTRIBUTED_CLASS_SHM__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+#define SHM_RING_SIZE      16384  // bytes in one ring buffer (power of two)
+#define SHM_MIN_RING_SIZE  8192   // bytes in one ring buffer for many processes (> message frame)
+#define SHM_REGION_LIMIT   (1UL << 30)  // bytes of region rings are shrunk to fit into
+#define SHM_BROADCAST_SIZE 16384  // bytes in one broadcast ring buffer (power of two)
+#define SHM_CACHE_LINE     64
+#define SHM_SPACE_SPIN_N   64  // checks of full ring before writer sleeps on own doorbell
+#define SHM_BROADCAST      -1  // destination of the executor broadcast ring
+
+/**
+ * Single producer single consumer ring. Positions are never wrapped, so tail - head is the number
+ * of used bytes. Producer and consumer positions are placed into different cache lines. There are
+ * proc_n * proc_n rings, so buffer size depends on proc_n (see get_shm_ring_size).
+ */
+typedef struct {
+    uint32_t tail __attribute__((aligned(SHM_CACHE_LINE)));  ///< Write position (producer only)
+    uint32_t head __attribute__((aligned(SHM_CACHE_LINE)));  ///< Read position (consumer only)
+    char     buffer[] __attribute__((aligned(SHM_CACHE_LINE)));
+} ShmRing;
+
+/**
+ * Single producer multiple consumers ring. Every multicast message is written once, every reader
+ * has own cursor (ShmCursor), the slot is reused when all readers moved their cursors past it.
+ */
+typedef struct {
+    uint32_t tail __attribute__((aligned(SHM_CACHE_LINE)));  ///< Write position (producer only)
+    char     buffer[SHM_BROADCAST_SIZE] __attribute__((aligned(SHM_CACHE_LINE)));
+} ShmBroadcastRing;
+
+/**
+ * Read position of one reader in the broadcast ring of one writer
+ */
+typedef struct {
+    uint32_t head __attribute__((aligned(SHM_CACHE_LINE)));  ///< Read position (consumer only)
+} ShmCursor;
+
+/**
+ * Messages from one process come from two rings. Every message of SPSC ring is prefixed with the
+ * number of multicast messages the writer published before it, so reader keeps messages of both
+ * rings in the order they were sent.
+ */
+/**
+ * Position of the next message of one writer in one of its rings
+ */
+typedef struct {
+    const char *buffer;        ///< Ring buffer
+    uint32_t    buffer_size;   ///< Ring buffer size
+    uint32_t    pos;           ///< Position of the message header
+    uint32_t    size;          ///< Ring bytes taken by the message (with multicast number prefix)
+    uint8_t     is_broadcast;  ///< Message is in the broadcast ring
+} ShmSlot;
+
+/**
+ * Writer of a full ring moves messages of its inbound rings into backlog while it waits, so two
+ * processes writing to each other do not wait forever. Backlog is read before the rings.
+ */
+typedef struct {
+    uint32_t      multicast_sent_n;     ///< Multicast messages published by the executor
+    uint32_t     *multicast_read_n;     ///< Multicast messages read (indexed by writer local id)
+    uint32_t      doorbell_sleep_n;     ///< Executor sleeps on own doorbell
+    uint32_t      doorbell_wake_n;      ///< Executor wakes of sleeping receivers
+    uint32_t      space_wait_n;         ///< Executor waits for space in full outbound ring
+    PendingQueue *backlog;              ///< Drained messages (indexed by writer local id)
+    Message       drained;              ///< Buffer of the drained message
+    ShmSlot       borrowed;             ///< Slot of the borrowed message
+    local_id      borrowed_from;        ///< Writer of the borrowed slot, -1 if none
+    uint8_t       is_backlog_borrowed;  ///< Borrowed message is the backlog head
+} ShmState;
+
+/**
+ * Doorbell of process inbound rings. Sender bumps seq after publishing a message and wakes the
+ * receiver if it sleeps. Receiver sleeps on seq (FUTEX_WAIT) when all its rings are empty, value
+ * of seq read before checking rings makes the sleep return at once if a message was published
+ * after the check. Writer of a full ring sleeps on the same seq with space_waiters mark, reader
+ * bumps seq of the marked writer after freeing a slot.
+ */
+typedef struct {
+    uint32_t seq __attribute__((aligned(SHM_CACHE_LINE)));  ///< Published messages counter
+    uint32_t waiters;                                       ///< Receiver sleeps on seq
+    uint32_t space_waiters;  ///< Writer sleeps on seq until its full ring has space
+} ShmDoorbell;
+
+/**
+ * @brief      Gets the size of ring buffer for the number of processes: SHM_RING_SIZE, halved while
+ * the region is larger than SHM_REGION_LIMIT, but not less than SHM_MIN_RING_SIZE.
+ *
+ * @param[in]  proc_n  The number of processes
+ *
+ * @return     The ring buffer size (power of two).
+ */
+uint32_t get_shm_ring_size(int16_t proc_n);
+
+/**
+ * @brief      Gets the size of shared memory region for the number of processes.
+ *
+ * @param[in]  proc_n  The number of processes
+ *
+ * @return     The region size in bytes.
+ */
+size_t get_shm_region_size(int16_t proc_n);
+
+/**
+ * @brief      Determines if region for the number of processes fits into SHM_REGION_LIMIT.
+ *
+ * @param[in]  proc_n  The number of processes
+ *
+ * @return     1 if shared memory transport can be used, 0 otherwise.
+ */
+int is_shm_proc_n_supported(int16_t proc_n);
+
+/**
+ * @brief      Maps shared memory region with rings for every directed pair of processes, broadcast
+ * rings with readers cursors and doorbells for every process. Must be called before fork.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix (unused)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_shm_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sets the executor shared memory channels.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      executor  The executor
+ * @param      channels  The channels matrix (unused)
+ */
+void set_executor_shm_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Unmaps shared memory region.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix (unused)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_shm_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Writes a message to the ring self -> dst and rings the dst doorbell. Waits until dst
+ * reads enough messages if the ring is full, moving inbound messages into the backlog meanwhile.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error (message is longer than the ring)
+ */
+int write_shm_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Writes a message once to the self broadcast ring and rings doorbells of all other
+ * processes. Waits until the slowest reader frees enough space if the ring is full (inbound
+ * messages are moved into the backlog meanwhile).
+ *
+ * @param      executor  The executor
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error (message is longer than the ring)
+ */
+int multicast_shm_channel(void *executor, const Message *msg);
+
+/**
+ * @brief      Reads the next message sent by process from (from the backlog, the ring from -> self
+ * or the broadcast ring of process from).
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if rings are empty
+ */
+int read_shm_channel(void *executor, local_id from, Message *msg);
+
+/**
+ * @brief      Borrows the next message sent by process from in place of its ring slot (message
+ * wrapped around the ring end is copied into the executor borrow buffer). Slot is not reused by
+ * the writer until the message is released.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ *
+ * @return     The message, NULL if rings are empty
+ */
+const Message *borrow_shm_channel(void *executor, local_id from);
+
+/**
+ * @brief      Releases the borrowed message slot back to the writer.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ */
+void release_shm_channel(void *executor, local_id from);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_SHM__H
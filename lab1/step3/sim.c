@@ -0,0 +1,397 @@
+// strtok_r is not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "sim.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "coroutine.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "msgpool.h"
+#include "transport.h"
+
+#define SIM_NOT_WAITING -2  // executor is running (or is not started yet)
+#define SIM_WAIT_ANY    -1  // executor waits for a message from any active link
+
+/**
+ * Simulated network of all processes (executors are coroutines of one thread)
+ */
+static struct {
+    const char *options;                         ///< Options string (see set_sim_options)
+    SimLink    *links;                           ///< Links matrix (row - src, col - dst)
+    int16_t     proc_n;                          ///< Number of processes
+    uint64_t    now;                             ///< Virtual time (usec)
+    uint64_t    random;                          ///< Random generator state
+    uint64_t    seed;                            ///< Random generator seed
+    executor   *executors[MAX_PROCESS_ID + 1];   ///< Executors (indexed by local id)
+    int         wait_from[MAX_PROCESS_ID + 1];   ///< Link executor waits for (indexed by local id)
+    int         waiting_n;                       ///< Number of executors waiting for messages
+    uint64_t    sent_n;                          ///< Number of sent messages
+    uint64_t    sent_bytes;                      ///< Number of sent bytes
+} sim;
+
+void set_sim_options(const char *options) {
+    sim.options = options;
+}
+
+/**
+ * @brief      Gets the link from -> dst.
+ */
+SimLink *get_sim_link(local_id from, local_id dst) {
+    return &sim.links[from * sim.proc_n + dst];
+}
+
+/**
+ * @brief      Next pseudo random number (xorshift64*), sequence depends only on seed.
+ */
+uint64_t next_sim_random() {
+    sim.random ^= sim.random >> 12;
+    sim.random ^= sim.random << 25;
+    sim.random ^= sim.random >> 27;
+    return sim.random * 2685821657736338717ULL;
+}
+
+/**
+ * @brief      Parse links file with parameters of separate links.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int load_sim_links(const char *path) {
+    FILE *file = fopen(path, "r");
+    char  line[SIM_LINE_LEN];
+    if (file == NULL) return 1;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        const char        *start = line + strspn(line, " \t");
+        int                from = 0;
+        int                dst = 0;
+        unsigned long long latency = 0;
+        unsigned long long jitter = 0;
+        unsigned long long bandwidth = 0;
+        if (*start == '#' || *start == '\n' || *start == '\0') continue;
+        int n = sscanf(start, "%d %d %llu %llu %llu", &from, &dst, &latency, &jitter, &bandwidth);
+        if (n != 5 || from < 0 || from >= sim.proc_n || dst < 0 || dst >= sim.proc_n
+            || bandwidth == 0) {
+            fclose(file);
+            errno = EINVAL;
+            return 1;
+        }
+        SimLink *link = get_sim_link(from, dst);
+        link->latency_us = latency;
+        link->jitter_us = jitter;
+        link->bandwidth = bandwidth;
+    }
+    fclose(file);
+    return 0;
+}
+
+/**
+ * @brief      Parse options string (key=value pairs separated with commas).
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int parse_sim_options(const char *options) {
+    SimLink     defaults = {
+            .latency_us = SIM_DEFAULT_LATENCY_US,
+            .jitter_us = SIM_DEFAULT_JITTER_US,
+            .bandwidth = SIM_DEFAULT_BANDWIDTH,
+    };
+    const char *links_path = NULL;
+    char       *copy = strdup(options == NULL ? "" : options);
+    char       *state = NULL;
+    int         rc = 0;
+    sim.seed = SIM_DEFAULT_SEED;
+    for (char *option = strtok_r(copy, ",", &state); option != NULL && rc == 0;
+         option = strtok_r(NULL, ",", &state)) {
+        char *value = strchr(option, '=');
+        char *end = NULL;
+        if (value == NULL) {
+            rc = 1;
+            break;
+        }
+        *value++ = '\0';
+        if (strcmp(option, "links") == 0) {
+            links_path = options + (value - copy);
+            continue;
+        }
+        unsigned long long number = strtoull(value, &end, 10);
+        if (*value == '\0' || *end != '\0') rc = 1;
+        else if (strcmp(option, "latency") == 0) defaults.latency_us = number;
+        else if (strcmp(option, "jitter") == 0) defaults.jitter_us = number;
+        else if (strcmp(option, "bandwidth") == 0 && number > 0) defaults.bandwidth = number;
+        else if (strcmp(option, "seed") == 0) sim.seed = number;
+        else rc = 1;
+    }
+    for (int i = 0; i < sim.proc_n * sim.proc_n; ++i) sim.links[i] = defaults;
+    // links path is the rest of options (file name can not contain commas)
+    if (rc == 0 && links_path != NULL) {
+        char *path = strdup(links_path);
+        path[strcspn(path, ",")] = '\0';
+        rc = load_sim_links(path);
+        free(path);
+    }
+    free(copy);
+    if (rc != 0 && errno == 0) errno = EINVAL;
+    return rc;
+}
+
+int open_sim_channels(int16_t proc_n, channel **channels) {
+    sim.proc_n = proc_n;
+    sim.now = 0;
+    sim.waiting_n = 0;
+    sim.sent_n = 0;
+    sim.sent_bytes = 0;
+    sim.links = calloc(proc_n * proc_n, sizeof(SimLink));
+    if (sim.links == NULL) return 1;
+    errno = 0;
+    if (parse_sim_options(sim.options) != 0) return 1;
+    // seed is mixed, so zero seed gives a valid generator state too
+    sim.random = sim.seed ^ 0x9E3779B97F4A7C15ULL;
+    for (local_id from = 0; from < proc_n; ++from) {
+        sim.wait_from[from] = SIM_NOT_WAITING;
+        for (local_id dst = 0; dst < proc_n; ++dst) {
+            if (from == dst) continue;
+            SimLink *link = get_sim_link(from, dst);
+            log_pipes_msg(
+                log_sim_channel_opened_fmt, from, dst, (unsigned long long)link->latency_us,
+                (unsigned long long)link->jitter_us, (unsigned long long)link->bandwidth
+            );
+        }
+    }
+    return 0;
+}
+
+void set_executor_sim_channels(int16_t proc_n, void *self, channel **channels) {
+    executor *executor = self;
+    executor->transport_state = NULL;
+    executor->ch_read = NULL;
+    executor->ch_write = NULL;
+    executor->poll_h = -1;
+    executor->poll_n = 0;
+    for (local_id from = 0; from < proc_n; ++from) {
+        executor->poll_state[from] = from == executor->local_id ? POLL_CLOSED : POLL_ACTIVE;
+        executor->poll_n += from != executor->local_id;
+    }
+    sim.executors[executor->local_id] = executor;
+}
+
+int close_unused_sim_channels(int16_t proc_n, local_id local_id, channel **channels) {
+    return 0;
+}
+
+int close_sim_channels(int16_t proc_n, channel **channels) {
+    if (sim.links == NULL) return 0;
+    for (int i = 0; i < proc_n * proc_n; ++i) {
+        while (sim.links[i].head != NULL) {
+            SimMessage *message = sim.links[i].head;
+            sim.links[i].head = message->next;
+            release_msg(message->msg);
+            free(message);
+        }
+    }
+    free(sim.links);
+    sim.links = NULL;
+    log_pipes_msg(
+        log_sim_finished_fmt, (unsigned long long)sim.now, (unsigned long long)sim.sent_n,
+        (unsigned long long)sim.sent_bytes, (unsigned long long)sim.seed
+    );
+    return 0;
+}
+
+void cleanup_sim_executor(void *self) {
+    executor *executor = self;
+    sim.executors[executor->local_id] = NULL;
+}
+
+/**
+ * @brief      Put a pool message in flight on the link self -> dst (link holds the message).
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int queue_sim_message(executor *executor, local_id dst, Message *msg) {
+    SimLink    *link = get_sim_link(executor->local_id, dst);
+    uint32_t    size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    SimMessage *message = malloc(sizeof(SimMessage));
+    if (message == NULL) return 1;
+    // message is transmitted after messages queued before it, then propagates
+    uint64_t start = link->free_at > sim.now ? link->free_at : sim.now;
+    link->free_at = start + (uint64_t)size * 1000000 / link->bandwidth;
+    uint64_t jitter = link->jitter_us > 0 ? next_sim_random() % (link->jitter_us + 1) : 0;
+    message->deliver_at = link->free_at + link->latency_us + jitter;
+    // jitter must not reorder messages of one link
+    if (message->deliver_at < link->last_deliver_at) message->deliver_at = link->last_deliver_at;
+    link->last_deliver_at = message->deliver_at;
+    message->msg = hold_msg(msg);
+    message->next = NULL;
+    if (link->tail == NULL) link->head = message;
+    else link->tail->next = message;
+    link->tail = message;
+    sim.sent_n++;
+    sim.sent_bytes += size;
+    return 0;
+}
+
+int write_sim_channel(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    Message  *copy = clone_msg(&executor->msg_pool, msg);
+    if (copy == NULL) return 1;
+    int rc = queue_sim_message(executor, dst, copy);
+    release_msg(copy);
+    return rc;
+}
+
+int multicast_sim_channel(void *self, const Message *msg) {
+    executor *executor = self;
+    Message  *copy = clone_msg(&executor->msg_pool, msg);
+    if (copy == NULL) return 1;
+    int rc = 0;
+    // one copy is shared by links to all destinations
+    for (local_id dst = 0; dst < executor->proc_n && rc == 0; ++dst) {
+        if (dst != executor->local_id) rc = queue_sim_message(executor, dst, copy);
+    }
+    release_msg(copy);
+    return rc;
+}
+
+/**
+ * @brief      Determines if link from -> dst has a delivered message.
+ */
+int is_sim_link_ready(local_id from, local_id dst) {
+    SimLink *link = get_sim_link(from, dst);
+    return link->head != NULL && link->head->deliver_at <= sim.now;
+}
+
+int read_sim_channel(void *self, local_id from, Message *msg) {
+    executor      *executor = self;
+    const Message *borrowed = borrow_sim_channel(executor, from);
+    if (borrowed == NULL) return -1;
+    memcpy(msg, borrowed, sizeof(MessageHeader) + borrowed->s_header.s_payload_len);
+    release_sim_channel(executor, from);
+    return 0;
+}
+
+const Message *borrow_sim_channel(void *self, local_id from) {
+    executor *executor = self;
+    if (!is_sim_link_ready(from, executor->local_id)) return NULL;
+    return get_sim_link(from, executor->local_id)->head->msg;
+}
+
+void release_sim_channel(void *self, local_id from) {
+    executor   *executor = self;
+    SimLink    *link = get_sim_link(from, executor->local_id);
+    SimMessage *message = link->head;
+    link->head = message->next;
+    if (link->head == NULL) link->tail = NULL;
+    release_msg(message->msg);
+    free(message);
+}
+
+/**
+ * @brief      Collect links with delivered messages executor waits for.
+ *
+ * @return     Number of ready links
+ */
+int collect_sim_ready(executor *executor, int wait_from, local_id *ready) {
+    int ready_n = 0;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (wait_from == SIM_WAIT_ANY && executor->poll_state[from] != POLL_ACTIVE) continue;
+        if (wait_from != SIM_WAIT_ANY && wait_from != from) continue;
+        if (is_sim_link_ready(from, executor->local_id)) ready[ready_n++] = from;
+    }
+    return ready_n;
+}
+
+/**
+ * @brief      Determines if some executor waiting for messages can continue at current time.
+ */
+int is_sim_progress_possible() {
+    local_id ready[MAX_PROCESS_ID + 1];
+    for (local_id id = 0; id < sim.proc_n; ++id) {
+        if (sim.executors[id] == NULL || sim.wait_from[id] == SIM_NOT_WAITING) continue;
+        if (collect_sim_ready(sim.executors[id], sim.wait_from[id], ready) > 0) return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief      Move virtual clock to the next message delivery.
+ *
+ * @return     0 on success, 1 if there are no messages in flight (executors wait forever)
+ */
+int advance_sim_time() {
+    uint64_t next = UINT64_MAX;
+    for (int i = 0; i < sim.proc_n * sim.proc_n; ++i) {
+        SimMessage *head = sim.links[i].head;
+        if (head != NULL && head->deliver_at > sim.now && head->deliver_at < next) {
+            next = head->deliver_at;
+        }
+    }
+    if (next == UINT64_MAX) return 1;
+    sim.now = next;
+    return 0;
+}
+
+/**
+ * @brief      Wait for messages on links wait_from (SIM_WAIT_ANY or process local id).
+ *
+ * @return     Number of ready links, -1 on error
+ */
+int wait_sim(executor *executor, int wait_from, local_id *ready, int timeout) {
+    int ready_n = 0;
+    sim.wait_from[executor->local_id] = wait_from;
+    while ((ready_n = collect_sim_ready(executor, wait_from, ready)) == 0) {
+        if (timeout != POLL_BLOCK) break;
+        if (wait_from == SIM_WAIT_ANY && executor->poll_n == 0) {
+            ready_n = -1;
+            break;
+        }
+        sim.waiting_n++;
+        // time moves only when every executor waits and nobody can continue at current time
+        if (sim.waiting_n < get_live_coroutines_n() || is_sim_progress_possible()) {
+            yield_coroutine();
+        } else if (advance_sim_time() != 0) {
+            ready_n = -1;
+        }
+        sim.waiting_n--;
+        if (ready_n < 0) break;
+    }
+    sim.wait_from[executor->local_id] = SIM_NOT_WAITING;
+    return ready_n;
+}
+
+int wait_sim_ready(void *self, local_id *ready, int timeout) {
+    executor *executor = self;
+    if (executor->poll_n == 0) return -1;
+    return wait_sim(executor, SIM_WAIT_ANY, ready, timeout);
+}
+
+int wait_sim_one_ready(void *self, local_id from, int timeout) {
+    executor *executor = self;
+    local_id  ready[MAX_PROCESS_ID + 1];
+    return wait_sim(executor, from, ready, timeout);
+}
+
+const transport sim_transport = {
+    .name = "sim",
+    .is_thread_safe = 1,
+    .is_simulated = 1,
+    .open = open_sim_channels,
+    .set_executor = set_executor_sim_channels,
+    .close_unused = close_unused_sim_channels,
+    .close = close_sim_channels,
+    .cleanup = cleanup_sim_executor,
+    .write = write_sim_channel,
+    .multicast = multicast_sim_channel,
+    .read = read_sim_channel,
+    .borrow = borrow_sim_channel,
+    .release = release_sim_channel,
+    .wait_ready = wait_sim_ready,
+    .wait_one_ready = wait_sim_one_ready,
+    .mask = mask_poll_state,
+    .unmask = unmask_poll_state,
+};
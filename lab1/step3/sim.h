@@ -0,0 +1,138 @@
+/**
+ * @file     sim.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Discrete-event network simulator transport: messages are delivered on a virtual clock
+ * to executors running as coroutines
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_SIM__H
+#define __ITMO_DISTRIBUTED_CLASS_SIM__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+#define SIM_DEFAULT_LATENCY_US 100       // link latency without options
+#define SIM_DEFAULT_JITTER_US  0         // max random addition to latency without options
+#define SIM_DEFAULT_BANDWIDTH  125000000 // link bytes per second without options (1 Gbit)
+#define SIM_DEFAULT_SEED       1         // random generator seed without options
+#define SIM_LINE_LEN           256       // max links file line length
+
+/**
+ * Message in flight
+ */
+typedef struct SimMessage {
+    struct SimMessage *next;        ///< Next message of the same link
+    uint64_t           deliver_at;  ///< Virtual time (usec) message becomes readable at
+    Message           *msg;         ///< Sender pool message (shared by links of one multicast)
+} SimMessage;
+
+/**
+ * Directed link between two processes. Messages of a link are delivered in order they were sent.
+ */
+typedef struct {
+    uint64_t    latency_us;       ///< Propagation delay
+    uint64_t    jitter_us;        ///< Max random addition to propagation delay
+    uint64_t    bandwidth;        ///< Bytes per second (transmission delay is size / bandwidth)
+    uint64_t    free_at;          ///< Virtual time link finishes transmitting queued messages
+    uint64_t    last_deliver_at;  ///< Delivery time of the last sent message
+    SimMessage *head;             ///< First message in flight
+    SimMessage *tail;             ///< Last message in flight
+} SimLink;
+
+/**
+ * @brief      Sets the simulation options: comma separated list of latency=USEC, jitter=USEC,
+ * bandwidth=BYTES_PER_SEC, seed=N and links=FILE. Links file overrides parameters of separate
+ * links with "from dst latency jitter bandwidth" lines ('#' lines are comments).
+ *
+ * @param[in]  options  The options (NULL for defaults)
+ */
+void set_sim_options(const char *options);
+
+/**
+ * @brief      Parses options and creates links for every directed pair of processes.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix (unused)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_sim_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Frees messages in flight and prints simulation statistics.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix (unused)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_sim_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sends a message through the link self -> dst. Message becomes readable after
+ * transmission (size / bandwidth, after messages queued before it) and propagation (latency and
+ * random jitter) delays.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int write_sim_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Sends a message to all other processes: message is copied into the sender pool once
+ * and the copy is shared by all links (every link holds a reference until delivery).
+ *
+ * @param      executor  The executor
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int multicast_sim_channel(void *executor, const Message *msg);
+
+/**
+ * @brief      Receives a delivered message from the link from -> self.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no delivered message
+ */
+int read_sim_channel(void *executor, local_id from, Message *msg);
+
+/**
+ * @brief      Borrows a delivered message from the link from -> self in place.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ *
+ * @return     The message, NULL if there is no delivered message
+ */
+const Message *borrow_sim_channel(void *executor, local_id from);
+
+/**
+ * @brief      Removes the borrowed message from the link.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ */
+void release_sim_channel(void *executor, local_id from);
+
+/**
+ * @brief      Wait until some links have delivered messages. Executor yields to other coroutines
+ * while it waits, virtual clock moves to the next delivery when no executor can continue.
+ */
+int wait_sim_ready(void *executor, local_id *ready, int timeout);
+
+/**
+ * @brief      Wait until the link from specified process has a delivered message. See
+ * wait_sim_ready
+ */
+int wait_sim_one_ready(void *executor, local_id from, int timeout);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_SIM__H
@@ -0,0 +1,205 @@
+#include "tcp.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "logger.h"
+#include "tcp_socket.h"
+#include "transport.h"
+
+static const char *nodes_path = NULL;
+static TcpNode     nodes[MAX_PROCESS_ID + 1];
+
+void set_tcp_nodes_path(const char *path) {
+    nodes_path = path;
+}
+
+/**
+ * @brief      Parse a node map line "local_id host:port" (host can be in brackets for IPv6).
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int parse_tcp_node(const char *line, int16_t proc_n) {
+    int   id = 0;
+    int   port = 0;
+    char  address[TCP_NODE_LINE_LEN];
+    char *port_start = NULL;
+    if (sscanf(line, "%d %127s", &id, address) != 2 || id < 0 || id >= proc_n) return 1;
+    if ((port_start = strrchr(address, ':')) == NULL) return 1;
+    *port_start++ = '\0';
+    if (sscanf(port_start, "%d", &port) != 1 || port <= 0 || port > UINT16_MAX) return 1;
+    char  *host = address;
+    size_t host_len = strlen(host);
+    if (host_len >= 2 && host[0] == '[' && host[host_len - 1] == ']') {
+        host[host_len - 1] = '\0';
+        host++;
+    }
+    if (strlen(host) == 0 || strlen(host) >= TCP_HOST_LEN) return 1;
+    strcpy(nodes[id].host, host);
+    nodes[id].port = port;
+    return 0;
+}
+
+int load_tcp_nodes(int16_t proc_n) {
+    for (int id = 0; id < proc_n; ++id) {
+        strcpy(nodes[id].host, TCP_DEFAULT_HOST);
+        nodes[id].port = TCP_BASE_PORT + id;
+    }
+    if (nodes_path == NULL) return 0;
+    FILE *file = fopen(nodes_path, "r");
+    char  line[TCP_NODE_LINE_LEN];
+    if (file == NULL) return 1;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        const char *start = line + strspn(line, " \t");
+        if (*start == '#' || *start == '\n' || *start == '\0') continue;
+        if (parse_tcp_node(start, proc_n) != 0) {
+            fclose(file);
+            errno = EINVAL;
+            return 1;
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+int open_tcp_channels(int16_t proc_n, channel **channels) {
+    // closed connection is handled by write result, not by signal
+    signal(SIGPIPE, SIG_IGN);
+    if (load_tcp_nodes(proc_n) != 0) return 1;
+    for (int from = 0; from < proc_n; ++from) {
+        for (int dst = 0; dst < proc_n; ++dst) {
+            channels[from][dst].read_h = -1;
+            channels[from][dst].write_h = -1;
+        }
+    }
+    for (int id = 0; id < proc_n; ++id) {
+        int listener = open_tcp_listener(nodes[id].host, nodes[id].port);
+        if (listener < 0) return 1;
+        channels[id][id].read_h = listener;
+        log_pipes_msg(log_tcp_listener_opened_fmt, id, listener, nodes[id].host, nodes[id].port);
+    }
+    return 0;
+}
+
+/**
+ * @brief      Connect to all processes with lower local ids and send them own local id. Listeners
+ * are bound before fork, so connections are not refused and are not retried.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int connect_tcp_nodes(local_id self, int *sockets) {
+    struct pollfd pfds[MAX_PROCESS_ID + 1];
+    local_id      ids[MAX_PROCESS_ID + 1];
+    uint8_t       is_connected[MAX_PROCESS_ID + 1] = {0};
+    int           connected_n = 0;
+    for (int id = 0; id < self; ++id) {
+        sockets[id] = start_tcp_connect(nodes[id].host, nodes[id].port);
+        if (sockets[id] < 0) return 1;
+    }
+    while (connected_n < self) {
+        int pfds_n = 0;
+        for (int id = 0; id < self; ++id) {
+            if (is_connected[id]) continue;
+            pfds[pfds_n].fd = sockets[id];
+            pfds[pfds_n].events = POLLOUT;
+            ids[pfds_n++] = id;
+        }
+        int rc = poll(pfds, pfds_n, TCP_CONNECT_TIMEOUT_MSEC);
+        if (rc < 0 && errno == EINTR) continue;
+        if (rc <= 0) {
+            if (rc == 0) errno = ETIMEDOUT;
+            return 1;
+        }
+        for (int i = 0; i < pfds_n; ++i) {
+            int id = ids[i];
+            if (pfds[i].revents == 0) continue;
+            int error = get_tcp_connect_error(sockets[id]);
+            if (error != 0) {
+                errno = error;
+                return 1;
+            }
+            if (send_tcp_bytes(sockets[id], &self, sizeof(self)) != 0) return 1;
+            log_pipes_msg(
+                log_tcp_channel_opened_fmt, self, id, sockets[id], nodes[id].host, nodes[id].port
+            );
+            is_connected[id] = 1;
+            connected_n++;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief      Accept connections from all processes with higher local ids (process is identified
+ * by local id sent first).
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int accept_tcp_nodes(int16_t proc_n, local_id self, int listener, int *sockets) {
+    for (int id = self + 1; id < proc_n; ++id) sockets[id] = -1;
+    for (int accepted_n = self + 1; accepted_n < proc_n; ++accepted_n) {
+        int      fd = accept_tcp(listener);
+        local_id id = 0;
+        if (fd < 0) return 1;
+        if (recv_tcp_bytes(fd, &id, sizeof(id)) != 0 || id <= self || id >= proc_n
+            || sockets[id] != -1) {
+            close(fd);
+            return 1;
+        }
+        sockets[id] = fd;
+    }
+    return 0;
+}
+
+void set_executor_tcp_channels(int16_t proc_n, void *self, channel **channels) {
+    executor *executor = self;
+    local_id  local_id = executor->local_id;
+    int       sockets[MAX_PROCESS_ID + 1];
+    int       listener = channels[local_id][local_id].read_h;
+    for (int id = 0; id < proc_n; ++id) sockets[id] = -1;
+    if (connect_tcp_nodes(local_id, sockets) != 0
+        || accept_tcp_nodes(proc_n, local_id, listener, sockets) != 0) {
+        // executor can not run without full mesh, as with failed pipes
+        perror("Failed to establish tcp connections");
+        exit(1);
+    }
+    for (int other_id = 0; other_id < proc_n; ++other_id) {
+        if (other_id == local_id || sockets[other_id] < 0) continue;
+        if (set_tcp_options(sockets[other_id]) != 0) perror("Failed to set tcp options");
+        // separate handler for writing, so it is registered in poll independently of reading
+        channels[other_id][local_id].read_h = sockets[other_id];
+        channels[local_id][other_id].write_h = dup(sockets[other_id]);
+    }
+    set_executor_channels(proc_n, executor, channels);
+}
+
+int close_unused_tcp_channels(int16_t proc_n, local_id local_id, channel **channels) {
+    for (int id = 0; id < proc_n; ++id) close_channel_handler(&channels[id][id].read_h);
+    return close_unused_channels(proc_n, local_id, channels);
+}
+
+const transport tcp_transport = {
+    .name = "tcp",
+    .open = open_tcp_channels,
+    .set_executor = set_executor_tcp_channels,
+    .close_unused = close_unused_tcp_channels,
+    .close = close_channels,
+    .cleanup = cleanup_executor_channels,
+    .flush = flush_channels,
+    .write = write_channel,
+    .read = read_channel,
+    .borrow = borrow_channel,
+    .release = release_channel,
+    .wait_ready = wait_pipes_ready,
+    .wait_one_ready = wait_pipe_ready,
+    .mask = mask_pipe_poll,
+    .unmask = unmask_pipes_poll,
+};
@@ -0,0 +1,84 @@
+/**
+ * @file     tcp.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    TCP transport: one connection per pair of processes, addresses are taken from the
+ * node map, so processes can be placed on different hosts
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_TCP__H
+#define __ITMO_DISTRIBUTED_CLASS_TCP__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+#define TCP_DEFAULT_HOST         "127.0.0.1"  // host of every process without node map
+#define TCP_BASE_PORT            47000        // port of process 0 without node map (+ local id)
+#define TCP_HOST_LEN             64           // max host name length (with terminating zero)
+#define TCP_NODE_LINE_LEN        128          // max node map line length
+#define TCP_CONNECT_TIMEOUT_MSEC 1000         // max wait for any connection in progress
+
+/**
+ * Process listening address
+ */
+typedef struct {
+    char     host[TCP_HOST_LEN];  ///< Host name or address
+    uint16_t port;                ///< Port
+} TcpNode;
+
+/**
+ * @brief      Sets the node map file path. Every not empty line of the file (except '#'
+ * comments) is "local_id host:port". Processes missing in the file listen on
+ * TCP_DEFAULT_HOST:TCP_BASE_PORT + local_id.
+ *
+ * @param[in]  path  The node map file path (NULL for default addresses only)
+ */
+void set_tcp_nodes_path(const char *path);
+
+/**
+ * @brief      Loads the node map.
+ *
+ * @param[in]  proc_n  The number of processes
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int load_tcp_nodes(int16_t proc_n);
+
+/**
+ * @brief      Loads the node map and opens a listening socket of every process. Listener of
+ * process id is stored in channels[id][id].read_h (other handlers are set to -1). Must be called
+ * before fork.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_tcp_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Establishes the executor connections: process connects to all processes with lower
+ * local ids (connections are started together and completed with poll) and accepts connections
+ * from processes with higher local ids. Connection socket with process other is stored as
+ * channels[other][self].read_h and its copy as channels[self][other].write_h, then connections are
+ * used as pipes (messages are buffered and framed by the pipes backend).
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      executor  The executor
+ * @param      channels  The channels matrix
+ */
+void set_executor_tcp_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Closes listening sockets (all connections are established already).
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param[in]  local_id  The local identifier
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int close_unused_tcp_channels(int16_t proc_n, local_id local_id, channel **channels);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_TCP__H
@@ -0,0 +1,111 @@
+// getaddrinfo is not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "tcp_socket.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/**
+ * @brief      Resolve the address (first IPv4 or IPv6 result).
+ *
+ * @return     The address list (freed with freeaddrinfo), NULL on error
+ */
+struct addrinfo *resolve_tcp_address(const char *host, uint16_t port, int flags) {
+    struct addrinfo  hints;
+    struct addrinfo *result = NULL;
+    char             service[8];
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = flags;
+    snprintf(service, sizeof(service), "%u", port);
+    if (getaddrinfo(host, service, &hints, &result) != 0) return NULL;
+    return result;
+}
+
+int open_tcp_listener(const char *host, uint16_t port) {
+    struct addrinfo *address = resolve_tcp_address(host, port, AI_PASSIVE);
+    int              is_reused = 1;
+    if (address == NULL) return -1;
+    int fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (fd >= 0
+        && (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &is_reused, sizeof(is_reused)) != 0
+            || bind(fd, address->ai_addr, address->ai_addrlen) != 0
+            || listen(fd, SOMAXCONN) != 0)) {
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(address);
+    return fd;
+}
+
+int start_tcp_connect(const char *host, uint16_t port) {
+    struct addrinfo *address = resolve_tcp_address(host, port, 0);
+    if (address == NULL) return -1;
+    int fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (fd >= 0 && set_tcp_options(fd) == 0
+        && (connect(fd, address->ai_addr, address->ai_addrlen) == 0 || errno == EINPROGRESS)) {
+        freeaddrinfo(address);
+        return fd;
+    }
+    if (fd >= 0) close(fd);
+    freeaddrinfo(address);
+    return -1;
+}
+
+int get_tcp_connect_error(int fd) {
+    int       error = 0;
+    socklen_t size = sizeof(error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &size) != 0) return errno;
+    return error;
+}
+
+int accept_tcp(int listener) {
+    int fd = -1;
+    while ((fd = accept(listener, NULL, NULL)) < 0 && errno == EINTR) {}
+    return fd;
+}
+
+int set_tcp_options(int fd) {
+    int is_no_delay = 1;
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) != 0) return 1;
+    return setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &is_no_delay, sizeof(is_no_delay)) != 0;
+}
+
+int send_tcp_bytes(int fd, const void *data, size_t size) {
+    struct pollfd pfd = {.fd = fd, .events = POLLOUT};
+    size_t        sent = 0;
+    while (sent < size) {
+        // ipc.h send shadows the socket one, so sendto is used
+        ssize_t bytes
+            = sendto(fd, (const char *)data + sent, size - sent, MSG_NOSIGNAL, NULL, 0);
+        if (bytes > 0) sent += bytes;
+        else if (bytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) poll(&pfd, 1, -1);
+        else if (bytes < 0 && errno != EINTR) return 1;
+    }
+    return 0;
+}
+
+int recv_tcp_bytes(int fd, void *data, size_t size) {
+    struct pollfd pfd = {.fd = fd, .events = POLLIN};
+    size_t        received = 0;
+    while (received < size) {
+        ssize_t bytes = recv(fd, (char *)data + received, size - received, 0);
+        if (bytes > 0) received += bytes;
+        else if (bytes == 0) return 1;
+        else if (errno == EAGAIN || errno == EWOULDBLOCK) poll(&pfd, 1, -1);
+        else if (errno != EINTR) return 1;
+    }
+    return 0;
+}
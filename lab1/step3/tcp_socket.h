@@ -0,0 +1,83 @@
+/**
+ * @file     tcp_socket.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    TCP sockets calls (sys/socket.h is not included together with ipc.h, see packet.h)
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_TCP_SOCKET__H
+#define __ITMO_DISTRIBUTED_CLASS_TCP_SOCKET__H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief      Opens a listening socket bound to the address.
+ *
+ * @param[in]  host  The host name or address
+ * @param[in]  port  The port
+ *
+ * @return     The socket handler, -1 on error
+ */
+int open_tcp_listener(const char *host, uint16_t port);
+
+/**
+ * @brief      Opens a non blocking socket and starts connection to the address.
+ *
+ * @param[in]  host  The host name or address
+ * @param[in]  port  The port
+ *
+ * @return     The socket handler (connection is established or in progress), -1 on error
+ */
+int start_tcp_connect(const char *host, uint16_t port);
+
+/**
+ * @brief      Gets the result of connection started with start_tcp_connect (socket is writable).
+ *
+ * @param[in]  fd    The socket handler
+ *
+ * @return     0 if connection is established, error code otherwise
+ */
+int get_tcp_connect_error(int fd);
+
+/**
+ * @brief      Accepts a connection (waits for it).
+ *
+ * @param[in]  listener  The listening socket handler
+ *
+ * @return     The connection socket handler, -1 on error
+ */
+int accept_tcp(int listener);
+
+/**
+ * @brief      Sets connection options: non blocking mode and TCP_NODELAY (messages are coalesced
+ * by outbound buffers, so Nagle delay is not needed).
+ *
+ * @param[in]  fd    The socket handler
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int set_tcp_options(int fd);
+
+/**
+ * @brief      Sends bytes to the connected socket (used for connection handshake only).
+ *
+ * @param[in]  fd    The socket handler
+ * @param[in]  data  The bytes
+ * @param[in]  size  The number of bytes
+ *
+ * @return     0 if all bytes are sent, any non-zero value on error
+ */
+int send_tcp_bytes(int fd, const void *data, size_t size);
+
+/**
+ * @brief      Receives bytes from the connected socket (waits for all of them).
+ *
+ * @param[in]  fd    The socket handler
+ * @param      data  The bytes buffer
+ * @param[in]  size  The number of bytes
+ *
+ * @return     0 if all bytes are received, any non-zero value on error or closed connection
+ */
+int recv_tcp_bytes(int fd, void *data, size_t size);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_TCP_SOCKET__H
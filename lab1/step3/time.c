@@ -4,7 +4,8 @@
 #include "ipc.h"
 #include "util.h"
 
-static timestamp_t __local_time = MIN_T;
+// every executor has own clock, executors can be threads of one process (see --threads)
+static __thread timestamp_t __local_time = MIN_T;
 
 void next_tick(timestamp_t other_time) {
     timestamp_t prev = __local_time;
@@ -15,3 +16,7 @@ void next_tick(timestamp_t other_time) {
 timestamp_t get_lamport_time() {
     return __local_time;
 }
+
+void set_lamport_time(timestamp_t time) {
+    __local_time = time;
+}
@@ -20,4 +20,12 @@ int usleep(__useconds_t useconds);
 
 timestamp_t get_lamport_time();
 
+/**
+ * @brief      Sets the clock of current thread (executors switched inside one thread keep own
+ * time).
+ *
+ * @param[in]  time  The local time
+ */
+void set_lamport_time(timestamp_t time);
+
 #endif  // __IFMO_DISTRIBUTED_CLASS_TIME__H
@@ -0,0 +1,145 @@
+#include "transport.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "channels.h"
+#include "executor.h"
+#include "lane.h"
+#include "tree.h"
+#include "wait.h"
+
+static const transport *const transports[] = {
+    &pipe_transport,  &shm_transport,       &inbox_transport,
+    &uring_transport, &seqpacket_transport, &tcp_transport, &sim_transport, &lazy_transport,
+};
+
+const transport *find_transport(const char *name) {
+    for (size_t i = 0; i < sizeof(transports) / sizeof(transports[0]); ++i) {
+        if (strcmp(transports[i]->name, name) == 0) return transports[i];
+    }
+    return NULL;
+}
+
+const transport *get_default_transport() {
+    return &pipe_transport;
+}
+
+const transport *get_default_thread_transport() {
+    return &shm_transport;
+}
+
+int flush_all(void *self) {
+    executor *executor = self;
+    if (executor->transport->flush == NULL) return 0;
+    return executor->transport->flush(executor);
+}
+
+const Message *borrow_channel_msg(void *self, local_id from) {
+    executor *executor = self;
+    if (executor->transport->borrow != NULL) return executor->transport->borrow(executor, from);
+    if (executor->transport->read(executor, from, executor->borrowed) == 0) {
+        return executor->borrowed;
+    }
+    return NULL;
+}
+
+void release_channel_msg(void *self, local_id from) {
+    executor *executor = self;
+    if (executor->transport->release != NULL) executor->transport->release(executor, from);
+}
+
+/**
+ * @brief      Wait policy probe for wait_channels_ready (arg is ready array).
+ */
+int probe_channels_ready(void *self, void *arg, int timeout) {
+    executor *executor = self;
+    if (is_tree_enabled()) return wait_tree_ready(executor, arg, timeout);
+    return executor->transport->wait_ready(executor, arg, timeout);
+}
+
+/**
+ * @brief      Wait policy probe for wait_channel_ready (arg is from local id pointer).
+ */
+int probe_channel_ready(void *self, void *arg, int timeout) {
+    executor *executor = self;
+    if (is_tree_enabled()) return wait_tree_one_ready(executor, *(local_id *)arg, timeout);
+    return executor->transport->wait_one_ready(executor, *(local_id *)arg, timeout);
+}
+
+/**
+ * @brief      Determines if channel is excluded from waiting (origin of tree messages is masked
+ * instead of transport channel).
+ */
+int is_channel_masked(executor *executor, local_id from) {
+    if (is_tree_enabled()) return is_tree_masked(&executor->tree, from);
+    return executor->poll_state[from] == POLL_MASKED;
+}
+
+/**
+ * @brief      Collect channels with bulk messages which are already read from transport.
+ *
+ * @return     The number of such channels.
+ */
+int collect_lane_ready(executor *executor, local_id *ready) {
+    int ready_n = 0;
+    for (int from = 0; from < executor->proc_n; ++from) {
+        if (is_channel_masked(executor, from)) continue;
+        if (has_bulk_msgs(&executor->lanes, from)) ready[ready_n++] = from;
+    }
+    return ready_n;
+}
+
+int wait_channels_ready(void *self, local_id *ready, int timeout) {
+    executor *executor = self;
+    local_id  polled[MAX_PROCESS_ID + 1];
+    flush_all(executor);
+    int ready_n = collect_lane_ready(executor, ready);
+    if (ready_n == 0) {
+        if (timeout != POLL_BLOCK) return probe_channels_ready(executor, ready, timeout);
+        return wait_by_policy(executor, probe_channels_ready, ready);
+    }
+    // buffered messages are ready, but transport may have control messages of other channels
+    int polled_n = probe_channels_ready(executor, polled, POLL_NOWAIT);
+    for (int i = 0; i < polled_n; ++i) {
+        if (!has_bulk_msgs(&executor->lanes, polled[i])) ready[ready_n++] = polled[i];
+    }
+    return ready_n;
+}
+
+int wait_channel_ready(void *self, local_id from, int timeout) {
+    executor *executor = self;
+    flush_all(executor);
+    if (has_bulk_msgs(&executor->lanes, from)) return 1;
+    if (timeout != POLL_BLOCK) return probe_channel_ready(executor, &from, timeout);
+    return wait_by_policy(executor, probe_channel_ready, &from);
+}
+
+void mask_channel_poll(void *self, local_id from) {
+    executor *executor = self;
+    // transport channels stay polled, so messages routed over tree are forwarded while waiting
+    if (is_tree_enabled()) mask_tree_poll(&executor->tree, from);
+    else executor->transport->mask(executor, from);
+}
+
+void unmask_channels_poll(void *self) {
+    executor *executor = self;
+    if (is_tree_enabled()) unmask_tree_poll(&executor->tree);
+    else executor->transport->unmask(executor);
+}
+
+void mask_poll_state(void *self, local_id from) {
+    executor *executor = self;
+    if (executor->poll_state[from] != POLL_ACTIVE) return;
+    executor->poll_state[from] = POLL_MASKED;
+    executor->poll_n--;
+}
+
+void unmask_poll_state(void *self) {
+    executor *executor = self;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (executor->poll_state[from] != POLL_MASKED) continue;
+        executor->poll_state[from] = POLL_ACTIVE;
+        executor->poll_n++;
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * @file     transport.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Transport backends interface (pipes, shared memory, etc.)
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_TRANSPORT__H
+#define __ITMO_DISTRIBUTED_CLASS_TRANSPORT__H
+
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+/**
+ * Transport backend operations. Mesh operations are called with the channels matrix (used only
+ * by pipes based backends), data operations are called with the executor pointer.
+ */
+typedef struct {
+    const char *name;            ///< Backend name used in command line
+    uint8_t     is_thread_safe;  ///< Can be used by executors running as threads of one process
+    uint8_t     is_simulated;    ///< Delivers on virtual time, executors have to run as coroutines
+
+    /**
+     * Open communication mesh for all processes (called in parent before fork)
+     */
+    int (*open)(int16_t proc_n, channel **channels);
+
+    /**
+     * Set executor communication handlers (called in each process after fork)
+     */
+    void (*set_executor)(int16_t proc_n, void *executor, channel **channels);
+
+    /**
+     * Close handlers that are not used by process with local_id (called after set_executor)
+     */
+    int (*close_unused)(int16_t proc_n, local_id local_id, channel **channels);
+
+    /**
+     * Close communication mesh (called in parent after all children are finished)
+     */
+    int (*close)(int16_t proc_n, channel **channels);
+
+    /**
+     * Release executor communication handlers and backend state (called on executor cleanup)
+     */
+    void (*cleanup)(void *executor);
+
+    /**
+     * Write message to the channel self -> dst. 0 on success, any non-zero value on error
+     */
+    int (*write)(void *executor, local_id dst, const Message *msg);
+
+    /**
+     * Write message to all other processes at once (nullable, write is called for every process
+     * otherwise). 0 on success, any non-zero value on error
+     */
+    int (*multicast)(void *executor, const Message *msg);
+
+    /**
+     * Write all buffered messages (nullable for backends without send buffering). 0 on success,
+     * any non-zero value if some messages are still buffered
+     */
+    int (*flush)(void *executor);
+
+    /**
+     * Read message from the channel from -> self. 0 on success, any non-zero value if there is no
+     * message or on error
+     */
+    int (*read)(void *executor, local_id from, Message *msg);
+
+    /**
+     * Get the next message from the channel from -> self without copying it out of the receive
+     * buffer (nullable, read into the executor borrow buffer is used otherwise). NULL if there is
+     * no message. See receive_borrow
+     */
+    const Message *(*borrow)(void *executor, local_id from);
+
+    /**
+     * Consume the message returned by borrow (nullable if borrow is NULL)
+     */
+    void (*release)(void *executor, local_id from);
+
+    /**
+     * Wait until channels have data to read. See wait_channels_ready
+     */
+    int (*wait_ready)(void *executor, local_id *ready, int timeout);
+
+    /**
+     * Wait until channel from -> self has data to read. See wait_channel_ready
+     */
+    int (*wait_one_ready)(void *executor, local_id from, int timeout);
+
+    /**
+     * Exclude channel from waiting. See mask_channel_poll
+     */
+    void (*mask)(void *executor, local_id from);
+
+    /**
+     * Return masked channels back to waiting. See unmask_channels_poll
+     */
+    void (*unmask)(void *executor);
+} transport;
+
+extern const transport pipe_transport;      ///< Pipes matrix backend (channels.c)
+extern const transport shm_transport;       ///< Shared memory rings backend (shm.c)
+extern const transport inbox_transport;     ///< Single inbox pipe per process backend (inbox.c)
+extern const transport uring_transport;     ///< Pipes matrix through io_uring backend (uring.c)
+extern const transport seqpacket_transport; ///< Unix socket pair per processes pair (seqpacket.c)
+extern const transport tcp_transport;       ///< TCP connection per processes pair (tcp.c)
+extern const transport sim_transport;       ///< Simulated network on virtual clock (sim.c)
+extern const transport lazy_transport;      ///< Pipes created by broker on first send (lazy.c)
+
+/**
+ * @brief      Find transport backend by name.
+ *
+ * @param[in]  name  The backend name
+ *
+ * @return     The transport backend pointer, NULL if there is no backend with such name
+ */
+const transport *find_transport(const char *name);
+
+/**
+ * @brief      Gets the default transport backend (pipes).
+ *
+ * @return     The default transport backend pointer.
+ */
+const transport *get_default_transport();
+
+/**
+ * @brief      Gets the default transport backend for executors running as threads of one
+ * process (shared memory).
+ *
+ * @return     The default thread safe transport backend pointer.
+ */
+const transport *get_default_thread_transport();
+
+/**
+ * @brief      Write all messages buffered by transport backend. Called before waiting for
+ * messages, so all messages sent during event loop iteration are written together.
+ *
+ * @param      executor  The executor
+ *
+ * @return     0 on success, any non-zero value if some messages are still buffered
+ */
+int flush_all(void *executor);
+
+/**
+ * @brief      Get the next message of the transport channel from -> self without copying it when
+ * transport supports borrowing (read into executor borrow buffer otherwise).
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ *
+ * @return     The message (valid until release_channel_msg) or NULL if there is no message
+ */
+const Message *borrow_channel_msg(void *executor, local_id from);
+
+/**
+ * @brief      Consume the message returned by borrow_channel_msg.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ */
+void release_channel_msg(void *executor, local_id from);
+
+/**
+ * @brief      Wait until some channels have data to read. Buffered messages are flushed first,
+ * POLL_BLOCK wait is done with executor wait policy. Channels with bulk messages put aside behind
+ * control messages (see lane.h) are ready without waiting. When messages are routed over tree
+ * (see tree.h), channels are origins of delivered messages.
+ *
+ * @param      executor  The executor
+ * @param      ready     The array (at least proc_n size) to write ready process local ids into
+ * @param[in]  timeout   The timeout in milliseconds (POLL_BLOCK or POLL_NOWAIT are possible)
+ *
+ * @return     Number of ready channels, -1 on error or if there are no channels to wait
+ */
+int wait_channels_ready(void *executor, local_id *ready, int timeout);
+
+/**
+ * @brief      Wait until a channel from specified process has data to read. Buffered messages are
+ * flushed first, POLL_BLOCK wait is done with executor wait policy. Channel with bulk messages put
+ * aside is ready without waiting.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param[in]  timeout   The timeout in milliseconds (POLL_BLOCK or POLL_NOWAIT are possible)
+ *
+ * @return     1 if channel is ready, 0 on timeout, -1 on error
+ */
+int wait_channel_ready(void *executor, local_id from, int timeout);
+
+/**
+ * @brief      Exclude a channel from specified process from waiting (until unmask).
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ */
+void mask_channel_poll(void *executor, local_id from);
+
+/**
+ * @brief      Return all masked channels back to waiting.
+ *
+ * @param      executor  The executor
+ */
+void unmask_channels_poll(void *executor);
+
+/**
+ * @brief      Mask implementation for backends without poll handler (only executor poll_state is
+ * changed).
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ */
+void mask_poll_state(void *executor, local_id from);
+
+/**
+ * @brief      Unmask implementation for backends without poll handler (only executor poll_state
+ * is changed).
+ *
+ * @param      executor  The executor
+ */
+void unmask_poll_state(void *executor);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_TRANSPORT__H
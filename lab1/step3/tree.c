@@ -0,0 +1,296 @@
+#include "tree.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bitset.h"
+#include "channels.h"
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "msgpool.h"
+#include "transport.h"
+
+static int tree_fanout = 0;
+
+void set_tree_fanout(int fanout) {
+    tree_fanout = fanout;
+}
+
+int get_tree_fanout() {
+    return tree_fanout;
+}
+
+int is_tree_enabled() {
+    return tree_fanout > 0;
+}
+
+/**
+ * @brief      Gets rank of process in the tree rooted at origin (origin has rank 0).
+ */
+int get_tree_rank(int16_t proc_n, local_id origin, local_id id) {
+    return (id - origin + proc_n) % proc_n;
+}
+
+int get_tree_children(int16_t proc_n, local_id origin, local_id self, local_id *children) {
+    int first = get_tree_rank(proc_n, origin, self) * tree_fanout + 1;
+    int children_n = 0;
+    for (int rank = first; rank < first + tree_fanout && rank < proc_n; ++rank) {
+        children[children_n++] = (rank + origin) % proc_n;
+    }
+    return children_n;
+}
+
+local_id get_tree_next_hop(int16_t proc_n, local_id origin, local_id self, local_id dst) {
+    int self_rank = get_tree_rank(proc_n, origin, self);
+    int rank = get_tree_rank(proc_n, origin, dst);
+    // go up from destination until parent is self
+    while (rank > 0 && (rank - 1) / tree_fanout != self_rank) rank = (rank - 1) / tree_fanout;
+    if (rank == 0) return dst;
+    return (rank + origin) % proc_n;
+}
+
+void init_tree(TreeState *tree, int16_t proc_n) {
+    memset(tree, 0, sizeof(TreeState));
+    tree->queues = calloc(proc_n, sizeof(TreeQueue));
+    tree->masked = new_bitset(proc_n);
+    tree->proc_n = proc_n;
+}
+
+void destroy_tree(TreeState *tree) {
+    for (local_id origin = 0; origin < tree->proc_n; ++origin) {
+        while (has_tree_msgs(tree, origin)) drop_tree_msg(tree, origin);
+    }
+    free(tree->queues);
+    free(tree->masked);
+    tree->queues = NULL;
+    tree->masked = NULL;
+    tree->proc_n = 0;
+}
+
+/**
+ * @brief      Puts pooled message to the tail of origin queue.
+ *
+ * @return     0 on success, -1 if message is NULL or item can not be allocated.
+ */
+int push_tree_msg(TreeState *tree, local_id origin, Message *msg) {
+    if (msg == NULL) return -1;
+    TreeItem *item = malloc(sizeof(TreeItem));
+    if (item == NULL) {
+        release_msg(msg);
+        return -1;
+    }
+    item->next = NULL;
+    item->msg = msg;
+    TreeQueue *queue = &tree->queues[origin];
+    if (queue->tail != NULL) queue->tail->next = item;
+    else queue->head = item;
+    queue->tail = item;
+    return 0;
+}
+
+int has_tree_msgs(const TreeState *tree, local_id origin) {
+    return tree->queues[origin].head != NULL;
+}
+
+const Message *peek_tree_msg(const TreeState *tree, local_id origin) {
+    if (!has_tree_msgs(tree, origin)) return NULL;
+    return tree->queues[origin].head->msg;
+}
+
+void drop_tree_msg(TreeState *tree, local_id origin) {
+    TreeQueue *queue = &tree->queues[origin];
+    TreeItem  *item = queue->head;
+    if (item == NULL) return;
+    queue->head = item->next;
+    if (queue->head == NULL) queue->tail = NULL;
+    release_msg(item->msg);
+    free(item);
+}
+
+/**
+ * @brief      Builds envelope of message to route it over tree.
+ *
+ * @return     The pooled envelope or NULL if message is too long to be wrapped.
+ */
+Message *wrap_tree_msg(MsgPool *pool, local_id origin, local_id dst, const Message *msg) {
+    Message *envelope = alloc_msg(pool, sizeof(TreeHeader) + msg->s_header.s_payload_len);
+    if (envelope == NULL) return NULL;
+    TreeHeader header = {.s_origin = origin, .s_dst = dst, .s_type = msg->s_header.s_type};
+    envelope->s_header = msg->s_header;
+    envelope->s_header.s_payload_len = sizeof(TreeHeader) + msg->s_header.s_payload_len;
+    envelope->s_header.s_type = TREE_ENVELOPE;
+    memcpy(envelope->s_payload, &header, sizeof(TreeHeader));
+    memcpy(envelope->s_payload + sizeof(TreeHeader), msg->s_payload, msg->s_header.s_payload_len);
+    return envelope;
+}
+
+/**
+ * @brief      Builds the original message of envelope.
+ *
+ * @return     The pooled message or NULL if it can not be allocated.
+ */
+Message *unwrap_tree_msg(MsgPool *pool, const TreeHeader *header, const Message *envelope) {
+    uint16_t payload_len = envelope->s_header.s_payload_len - sizeof(TreeHeader);
+    Message *msg = alloc_msg(pool, payload_len);
+    if (msg == NULL) return NULL;
+    msg->s_header = envelope->s_header;
+    msg->s_header.s_payload_len = payload_len;
+    msg->s_header.s_type = header->s_type;
+    memcpy(msg->s_payload, envelope->s_payload + sizeof(TreeHeader), payload_len);
+    return msg;
+}
+
+/**
+ * @brief      Writes envelope to the next process of the tree.
+ */
+int forward_tree_msg(
+    executor *executor, local_id dst, const TreeHeader *header, const Message *msg
+) {
+    debug_ipc_print(
+        debug_tree_forward_fmt, executor->local_id, executor->local_id, dst, header->s_origin,
+        header->s_dst
+    );
+    executor->tree.forwarded_n++;
+    return executor->transport->write(executor, dst, msg);
+}
+
+int route_tree_msg(void *self, local_id from, const Message *msg) {
+    executor  *executor = self;
+    TreeState *tree = &executor->tree;
+    TreeHeader header;
+    if (msg->s_header.s_type != TREE_ENVELOPE) {
+        return push_tree_msg(tree, from, clone_msg(&executor->msg_pool, msg));
+    }
+    if (msg->s_header.s_payload_len < sizeof(TreeHeader)) return -1;
+    memcpy(&header, msg->s_payload, sizeof(TreeHeader));
+    if (header.s_origin < 0 || header.s_origin >= executor->proc_n) return -1;
+    if (header.s_dst != TREE_MULTICAST && header.s_dst != executor->local_id) {
+        if (header.s_dst < 0 || header.s_dst >= executor->proc_n) return -1;
+        local_id next = get_tree_next_hop(
+            executor->proc_n, header.s_origin, executor->local_id, header.s_dst
+        );
+        return forward_tree_msg(executor, next, &header, msg);
+    }
+    int rc = 0;
+    if (header.s_dst == TREE_MULTICAST) {
+        // children get message before it is delivered, so forwarding does not wait for receiver
+        local_id children[MAX_PROCESS_ID + 1];
+        int      children_n = get_tree_children(
+            executor->proc_n, header.s_origin, executor->local_id, children
+        );
+        for (int i = 0; i < children_n; ++i) {
+            if (forward_tree_msg(executor, children[i], &header, msg) != 0) rc = -1;
+        }
+    }
+    Message *delivered = unwrap_tree_msg(&executor->msg_pool, &header, msg);
+    if (push_tree_msg(tree, header.s_origin, delivered) != 0) rc = -1;
+    return rc;
+}
+
+int send_tree_msg(void *self, local_id dst, const Message *msg) {
+    executor *executor = self;
+    Message  *envelope = wrap_tree_msg(&executor->msg_pool, executor->local_id, dst, msg);
+    if (envelope == NULL) return -1;
+    local_id next = get_tree_next_hop(
+        executor->proc_n, executor->local_id, executor->local_id, dst
+    );
+    int rc = executor->transport->write(executor, next, envelope);
+    release_msg(envelope);
+    return rc;
+}
+
+int multicast_tree_msg(void *self, const Message *msg) {
+    executor *executor = self;
+    local_id  children[MAX_PROCESS_ID + 1];
+    Message  *envelope = wrap_tree_msg(
+        &executor->msg_pool, executor->local_id, TREE_MULTICAST, msg
+    );
+    if (envelope == NULL) return -1;
+    int children_n = get_tree_children(
+        executor->proc_n, executor->local_id, executor->local_id, children
+    );
+    int rc = 0;
+    for (int i = 0; i < children_n && rc == 0; ++i) {
+        rc = executor->transport->write(executor, children[i], envelope);
+    }
+    release_msg(envelope);
+    return rc;
+}
+
+int pump_tree_channels(void *self) {
+    executor *executor = self;
+    local_id  ready[MAX_PROCESS_ID + 1];
+    uint32_t  forwarded_n = executor->tree.forwarded_n;
+    int       ready_n = executor->transport->wait_ready(executor, ready, POLL_NOWAIT);
+    for (int i = 0; i < ready_n; ++i) {
+        const Message *msg = NULL;
+        while ((msg = borrow_channel_msg(executor, ready[i])) != NULL) {
+            // dropped message would block its receiver forever, so waiting fails from now
+            if (route_tree_msg(executor, ready[i], msg) != 0) executor->tree.is_broken = 1;
+            release_channel_msg(executor, ready[i]);
+        }
+    }
+    // forwarded messages may be buffered by transport, and their receivers are waiting for them
+    if (executor->tree.forwarded_n != forwarded_n) flush_all(executor);
+    return executor->tree.is_broken ? -1 : ready_n;
+}
+
+/**
+ * @brief      Collect origins which have delivered messages and are not masked.
+ *
+ * @return     The number of such origins.
+ */
+int collect_tree_ready(executor *executor, local_id *ready) {
+    int ready_n = 0;
+    for (local_id origin = 0; origin < executor->proc_n; ++origin) {
+        if (is_tree_masked(&executor->tree, origin)) continue;
+        if (has_tree_msgs(&executor->tree, origin)) ready[ready_n++] = origin;
+    }
+    return ready_n;
+}
+
+int wait_tree_ready(void *self, local_id *ready, int timeout) {
+    executor *executor = self;
+    int       is_waited = 0;
+    while (1) {
+        int polled_n = pump_tree_channels(executor);
+        if (executor->tree.is_broken) return -1;
+        int ready_n = collect_tree_ready(executor, ready);
+        if (ready_n > 0) return ready_n;
+        if (polled_n < 0) return -1;
+        // timeout is not restarted, so messages forwarded during it do not extend waiting
+        if (timeout == POLL_NOWAIT || (timeout > 0 && is_waited)) return 0;
+        // messages read so far were forwarded to other processes or are masked
+        if (executor->transport->wait_ready(executor, ready, timeout) < 0) return -1;
+        is_waited = 1;
+    }
+}
+
+int wait_tree_one_ready(void *self, local_id origin, int timeout) {
+    executor *executor = self;
+    local_id  ready[MAX_PROCESS_ID + 1];
+    int       is_waited = 0;
+    while (1) {
+        int polled_n = pump_tree_channels(executor);
+        if (executor->tree.is_broken) return -1;
+        if (has_tree_msgs(&executor->tree, origin)) return 1;
+        if (polled_n < 0) return -1;
+        if (timeout == POLL_NOWAIT || (timeout > 0 && is_waited)) return 0;
+        if (executor->transport->wait_ready(executor, ready, timeout) < 0) return -1;
+        is_waited = 1;
+    }
+}
+
+void mask_tree_poll(TreeState *tree, local_id origin) {
+    set_bit(tree->masked, origin);
+}
+
+void unmask_tree_poll(TreeState *tree) {
+    memset(tree->masked, 0, BITSET_WORDS(tree->proc_n) * sizeof(bitset_word));
+}
+
+int is_tree_masked(const TreeState *tree, local_id origin) {
+    return is_bit_set(tree->masked, origin);
+}
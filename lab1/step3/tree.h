@@ -0,0 +1,239 @@
+/**
+ * @file     tree.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Dissemination of messages over k-ary tree of processes
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_TREE__H
+#define __ITMO_DISTRIBUTED_CLASS_TREE__H
+
+#include <stdint.h>
+
+#include "bitset.h"
+#include "ipc.h"
+#include "msgpool.h"
+
+#define TREE_ENVELOPE  0x100  // type of messages routed over tree (out of MessageType range)
+#define TREE_MULTICAST -1     // destination of messages delivered to all processes
+
+/**
+ * Envelope of message routed over tree, placed before the original payload. Header of envelope
+ * keeps the original Lamport time, so forwarding processes do not change it.
+ */
+typedef struct {
+    local_id s_origin;  ///< Process which sent the original message (root of the tree)
+    local_id s_dst;     ///< Destination process or TREE_MULTICAST
+    int16_t  s_type;    ///< Type of the original message
+} TreeHeader;
+
+/**
+ * Message delivered to process over tree and not received yet.
+ */
+typedef struct TreeItem {
+    struct TreeItem *next;  ///< Next message of the same origin
+    Message         *msg;   ///< Unwrapped pooled message (hold by item)
+} TreeItem;
+
+typedef struct {
+    TreeItem *head;  ///< The first message
+    TreeItem *tail;  ///< The last message
+} TreeQueue;
+
+/**
+ * Messages are routed over the tree rooted at their origin: multicast message goes down the whole
+ * tree and is forwarded by every inner process, message to one process goes down the path to it.
+ * All messages of one origin to one process share the path of FIFO channels, so per-sender order
+ * is kept. Delivered messages wait in queue of their origin, so channels of executor are logical
+ * (origin) ones, not the physical channels messages come from.
+ */
+typedef struct {
+    TreeQueue   *queues;       ///< Delivered messages of every origin
+    bitset_word *masked;       ///< Origins excluded from waiting
+    uint16_t     proc_n;       ///< Number of processes
+    uint32_t     forwarded_n;  ///< Number of messages forwarded to other processes
+    uint8_t      is_broken;    ///< Some message could not be routed (it is lost for its receiver)
+} TreeState;
+
+/**
+ * @brief      Set number of children of each process in tree.
+ *
+ * @param[in]  fanout  The number of children, 0 disables tree (sender writes to every process)
+ */
+void set_tree_fanout(int fanout);
+
+/**
+ * @brief      Gets number of children of each process in tree.
+ *
+ * @return     The number of children, 0 if tree is disabled.
+ */
+int get_tree_fanout();
+
+/**
+ * @brief      Determines if messages are routed over tree.
+ *
+ * @return     1 if tree is enabled, 0 otherwise.
+ */
+int is_tree_enabled();
+
+/**
+ * @brief      Gets children of process in the tree rooted at origin.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param[in]  origin    The root of the tree
+ * @param[in]  self      The process local id
+ * @param      children  The array (at least fanout size) to write children local ids into
+ *
+ * @return     The number of children.
+ */
+int get_tree_children(int16_t proc_n, local_id origin, local_id self, local_id *children);
+
+/**
+ * @brief      Gets the next process of the path from self to dst in the tree rooted at origin.
+ *
+ * @param[in]  proc_n  The number of processes
+ * @param[in]  origin  The root of the tree
+ * @param[in]  self    The process local id (origin or ancestor of dst)
+ * @param[in]  dst     The destination process local id
+ *
+ * @return     The child of self which is dst or its ancestor.
+ */
+local_id get_tree_next_hop(int16_t proc_n, local_id origin, local_id self, local_id dst);
+
+/**
+ * @brief      Initializes state without delivered messages.
+ *
+ * @param      tree    The tree state
+ * @param[in]  proc_n  The number of processes
+ */
+void init_tree(TreeState *tree, int16_t proc_n);
+
+/**
+ * @brief      Releases all delivered messages and state.
+ *
+ * @param      tree  The tree state
+ */
+void destroy_tree(TreeState *tree);
+
+/**
+ * @brief      Routes message to destination: writes it to the next processes of the tree and
+ * delivers it to executor if it is a destination. Non-envelope messages are delivered as is.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The local id of process message is read from
+ * @param[in]  msg       The message (can be released by caller after call)
+ *
+ * @return     0 on success, -1 if message can not be forwarded or delivered.
+ */
+int route_tree_msg(void *executor, local_id from, const Message *msg);
+
+/**
+ * @brief      Sends message to process over tree rooted at executor.
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int send_tree_msg(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Sends message to all other processes over tree rooted at executor (only children of
+ * executor are written to).
+ *
+ * @param      executor  The executor
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int multicast_tree_msg(void *executor, const Message *msg);
+
+/**
+ * @brief      Reads all messages available in transport and routes them without waiting.
+ *
+ * @param      executor  The executor
+ *
+ * @return     Number of ready transport channels, -1 if there are no channels to wait or some
+ * message can not be routed (tree is broken)
+ */
+int pump_tree_channels(void *executor);
+
+/**
+ * @brief      Determines if origin has delivered messages.
+ *
+ * @param      tree    The tree state
+ * @param[in]  origin  The origin local id
+ *
+ * @return     1 if there are delivered messages, 0 otherwise.
+ */
+int has_tree_msgs(const TreeState *tree, local_id origin);
+
+/**
+ * @brief      Gets the first delivered message of origin (stays valid until drop_tree_msg).
+ *
+ * @param      tree    The tree state
+ * @param[in]  origin  The origin local id
+ *
+ * @return     The message or NULL if there are no delivered messages.
+ */
+const Message *peek_tree_msg(const TreeState *tree, local_id origin);
+
+/**
+ * @brief      Removes the first delivered message of origin.
+ *
+ * @param      tree    The tree state
+ * @param[in]  origin  The origin local id
+ */
+void drop_tree_msg(TreeState *tree, local_id origin);
+
+/**
+ * @brief      Wait until some origins have delivered messages (transport channels are never
+ * masked, so messages of other processes are forwarded while executor waits).
+ *
+ * @param      executor  The executor
+ * @param      ready     The array (at least proc_n size) to write ready origin local ids into
+ * @param[in]  timeout   The timeout in milliseconds (POLL_BLOCK or POLL_NOWAIT are possible)
+ *
+ * @return     Number of ready origins, 0 on timeout, -1 if there are no messages and no channels to
+ * wait or some message can not be routed
+ */
+int wait_tree_ready(void *executor, local_id *ready, int timeout);
+
+/**
+ * @brief      Wait until origin has delivered messages.
+ *
+ * @param      executor  The executor
+ * @param[in]  origin    The origin local id
+ * @param[in]  timeout   The timeout in milliseconds (POLL_BLOCK or POLL_NOWAIT are possible)
+ *
+ * @return     1 if origin is ready, 0 on timeout, -1 if there are no channels to wait or some
+ * message can not be routed
+ */
+int wait_tree_one_ready(void *executor, local_id origin, int timeout);
+
+/**
+ * @brief      Exclude origin from waiting (until unmask).
+ *
+ * @param      tree    The tree state
+ * @param[in]  origin  The origin local id
+ */
+void mask_tree_poll(TreeState *tree, local_id origin);
+
+/**
+ * @brief      Return all masked origins back to waiting.
+ *
+ * @param      tree  The tree state
+ */
+void unmask_tree_poll(TreeState *tree);
+
+/**
+ * @brief      Determines if origin is excluded from waiting.
+ *
+ * @param      tree    The tree state
+ * @param[in]  origin  The origin local id
+ *
+ * @return     1 if origin is masked, 0 otherwise.
+ */
+int is_tree_masked(const TreeState *tree, local_id origin);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_TREE__H
@@ -0,0 +1,640 @@
+// syscall and MAP_ANONYMOUS are not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "uring.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "channels.h"
+#include "debug.h"
+#include "executor.h"
+#include "ipc.h"
+#include "transport.h"
+#include "util.h"
+
+#define URING_OP_READ_MULTISHOT 49       // IORING_OP_READ_MULTISHOT (linux 6.7, not in old headers)
+#define URING_PROBE_OPS_N       256      // operations in io_uring probe
+#define URING_WRITE_TAG         0x10000  // user data tag for write completions
+
+int uring_setup(unsigned entries, struct io_uring_params *params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+int uring_register(int ring_h, unsigned opcode, void *arg, unsigned nr_args) {
+    return (int)syscall(__NR_io_uring_register, ring_h, opcode, arg, nr_args);
+}
+
+int uring_enter(
+    int ring_h, unsigned to_submit, unsigned min_complete, unsigned flags, const void *arg,
+    size_t arg_size
+) {
+    return (int)syscall(
+        __NR_io_uring_enter, ring_h, to_submit, min_complete, flags, arg, arg_size
+    );
+}
+
+/**
+ * @brief      Check that kernel supports everything executor ring needs: ring itself and provided
+ * buffers ring registration (linux 5.19) within the locked memory limit.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int probe_uring() {
+    struct io_uring_params  params;
+    struct io_uring_buf_reg reg;
+    size_t                  page_size = sysconf(_SC_PAGESIZE);
+    memset(&params, 0, sizeof(params));
+    memset(&reg, 0, sizeof(reg));
+    int ring_h = uring_setup(1, &params);
+    if (ring_h < 0) return 1;
+    void *buf_ring = mmap(
+        NULL, page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    int rc = buf_ring == MAP_FAILED;
+    if (rc == 0) {
+        reg.ring_addr = (uintptr_t)buf_ring;
+        reg.ring_entries = URING_BUF_N;
+        rc = uring_register(ring_h, IORING_REGISTER_PBUF_RING, &reg, 1) != 0;
+        munmap(buf_ring, page_size);
+    }
+    close(ring_h);
+    return rc;
+}
+
+int open_uring_channels(int16_t proc_n, channel **channels) {
+    // fail early (before fork) if io_uring is not supported or not allowed
+    if (probe_uring() != 0) return 1;
+    return open_channels(proc_n, channels);
+}
+
+/**
+ * @brief      Map submission and completion queues of the executor ring.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int map_uring(UringState *state, struct io_uring_params *params) {
+    int prot = PROT_READ | PROT_WRITE;
+    state->sq_ring_size = params->sq_off.array + params->sq_entries * sizeof(unsigned);
+    state->cq_ring_size = params->cq_off.cqes + params->cq_entries * sizeof(struct io_uring_cqe);
+    if (params->features & IORING_FEAT_SINGLE_MMAP) {
+        state->sq_ring_size = max_v(state->sq_ring_size, state->cq_ring_size);
+        state->cq_ring_size = state->sq_ring_size;
+    }
+    state->sq_ring
+        = mmap(NULL, state->sq_ring_size, prot, MAP_SHARED, state->ring_h, IORING_OFF_SQ_RING);
+    if (state->sq_ring == MAP_FAILED) return 1;
+    if (params->features & IORING_FEAT_SINGLE_MMAP) {
+        state->cq_ring = state->sq_ring;
+    } else {
+        state->cq_ring
+            = mmap(NULL, state->cq_ring_size, prot, MAP_SHARED, state->ring_h, IORING_OFF_CQ_RING);
+        if (state->cq_ring == MAP_FAILED) return 1;
+    }
+    state->sqes = mmap(
+        NULL, params->sq_entries * sizeof(struct io_uring_sqe), prot, MAP_SHARED, state->ring_h,
+        IORING_OFF_SQES
+    );
+    if (state->sqes == MAP_FAILED) return 1;
+
+    char *sq_ring = state->sq_ring;
+    char *cq_ring = state->cq_ring;
+    state->sq_head = (unsigned *)(sq_ring + params->sq_off.head);
+    state->sq_tail = (unsigned *)(sq_ring + params->sq_off.tail);
+    state->sq_mask = (unsigned *)(sq_ring + params->sq_off.ring_mask);
+    state->sq_array = (unsigned *)(sq_ring + params->sq_off.array);
+    state->cq_head = (unsigned *)(cq_ring + params->cq_off.head);
+    state->cq_tail = (unsigned *)(cq_ring + params->cq_off.tail);
+    state->cq_mask = (unsigned *)(cq_ring + params->cq_off.ring_mask);
+    state->cqes = (struct io_uring_cqe *)(cq_ring + params->cq_off.cqes);
+    return 0;
+}
+
+/**
+ * @brief      Submit queued entries and wait for completions not longer than timeout (extended
+ * argument of io_uring_enter is supported since linux 5.11, provided buffer rings need 5.19).
+ *
+ * @param      state         The backend state
+ * @param[in]  min_complete  The number of completions to wait for (0 to submit only)
+ * @param[in]  timeout       The timeout in milliseconds (POLL_BLOCK to wait without timeout)
+ *
+ * @return     0 on success, -1 if timeout is expired, any other non-zero value on error
+ */
+int enter_uring_timeout(UringState *state, unsigned min_complete, int timeout) {
+    struct __kernel_timespec limit = {
+        .tv_sec = timeout / 1000, .tv_nsec = (timeout % 1000) * 1000000L
+    };
+    struct io_uring_getevents_arg arg = {.ts = (uintptr_t)&limit};
+    const void                   *arg_p = NULL;
+    size_t                        arg_size = 0;
+    unsigned                      flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int                           rc = 0;
+    if (min_complete > 0 && timeout > 0) {
+        flags |= IORING_ENTER_EXT_ARG;
+        arg_p = &arg;
+        arg_size = sizeof(arg);
+    }
+    while ((rc = uring_enter(state->ring_h, state->sq_queued, min_complete, flags, arg_p, arg_size))
+               < 0
+           && errno == EINTR) {}
+    state->enter_n++;
+    if (rc < 0) return errno == ETIME ? -1 : 1;
+    state->sq_queued -= rc;
+    state->sqe_n += rc;
+    return 0;
+}
+
+/**
+ * @brief      Submit queued entries and wait for completions.
+ *
+ * @param      state         The backend state
+ * @param[in]  min_complete  The number of completions to wait for (0 to submit only)
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int enter_uring(UringState *state, unsigned min_complete) {
+    return enter_uring_timeout(state, min_complete, POLL_BLOCK) != 0;
+}
+
+/**
+ * @brief      Get next free submission queue entry (queue is submitted first if it is full).
+ */
+struct io_uring_sqe *get_uring_sqe(UringState *state) {
+    unsigned tail = *state->sq_tail;
+    while (tail - __atomic_load_n(state->sq_head, __ATOMIC_ACQUIRE) > *state->sq_mask) {
+        if (enter_uring(state, 0) != 0) break;
+    }
+    unsigned             index = tail & *state->sq_mask;
+    struct io_uring_sqe *sqe = &state->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    state->sq_array[index] = index;
+    // kernel reads entries only in io_uring_enter, so entry is filled before that
+    __atomic_store_n(state->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    state->sq_queued++;
+    return sqe;
+}
+
+/**
+ * @brief      Return provided buffer of pipe from -> self to the kernel.
+ */
+void provide_uring_buf(UringInbound *in, uint16_t bid) {
+    // fields are set one by one: ring tail shares memory with the first entry
+    struct io_uring_buf *buf = &in->buf_ring->bufs[in->buf_tail & (URING_BUF_N - 1)];
+    buf->addr = (uintptr_t)(in->buf_data + (size_t)bid * URING_BUF_SIZE);
+    buf->len = URING_BUF_SIZE;
+    buf->bid = bid;
+    in->buf_tail++;
+    __atomic_store_n(&in->buf_ring->tail, in->buf_tail, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief      Register provided buffers ring for every reading pipe.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int init_uring_buffers(executor *executor) {
+    UringState *state = executor->transport_state;
+    size_t      page_size = sysconf(_SC_PAGESIZE);
+    size_t      pipe_data_size = URING_BUF_N * URING_BUF_SIZE;
+    state->buf_rings_size = page_size * executor->proc_n;
+    state->buf_rings = mmap(
+        NULL, state->buf_rings_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+    );
+    if (state->buf_rings == MAP_FAILED) {
+        state->buf_rings = NULL;
+        return 1;
+    }
+    state->buf_data = malloc(pipe_data_size * executor->proc_n);
+    if (state->buf_data == NULL) return 1;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        if (from == executor->local_id) continue;
+        UringInbound *in = &state->in[from];
+        in->buf_ring = (struct io_uring_buf_ring *)((char *)state->buf_rings + from * page_size);
+        in->buf_data = state->buf_data + from * pipe_data_size;
+
+        struct io_uring_buf_reg reg;
+        memset(&reg, 0, sizeof(reg));
+        reg.ring_addr = (uintptr_t)in->buf_ring;
+        reg.ring_entries = URING_BUF_N;
+        reg.bgid = from;
+        if (uring_register(state->ring_h, IORING_REGISTER_PBUF_RING, &reg, 1) != 0) return 1;
+        for (uint16_t bid = 0; bid < URING_BUF_N; ++bid) provide_uring_buf(in, bid);
+    }
+    return 0;
+}
+
+/**
+ * @brief      Gets the read operation: multishot read if kernel supports it, single read (armed
+ * again after every completion) otherwise.
+ */
+uint8_t get_uring_read_op(int ring_h) {
+    size_t                 size = sizeof(struct io_uring_probe)
+                + URING_PROBE_OPS_N * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe *probe = calloc(1, size);
+    uint8_t                read_op = IORING_OP_READ;
+    if (probe == NULL) return read_op;
+    if (uring_register(ring_h, IORING_REGISTER_PROBE, probe, URING_PROBE_OPS_N) == 0
+        && probe->last_op >= URING_OP_READ_MULTISHOT
+        && (probe->ops[URING_OP_READ_MULTISHOT].flags & IO_URING_OP_SUPPORTED)) {
+        read_op = URING_OP_READ_MULTISHOT;
+    }
+    free(probe);
+    return read_op;
+}
+
+/**
+ * @brief      Remove O_NONBLOCK flag from pipe handler. io_uring completes operations on non
+ * blocking handlers with EAGAIN instead of waiting for the pipe to be ready.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int set_uring_blocking(channel_h channel_h) {
+    int flags = fcntl(channel_h, F_GETFL);
+    if (flags < 0) return 1;
+    return fcntl(channel_h, F_SETFL, flags & ~O_NONBLOCK) != 0;
+}
+
+/**
+ * @brief      Queue read of pipe from -> self into its provided buffers.
+ */
+void arm_uring_read(executor *executor, local_id from) {
+    UringState          *state = executor->transport_state;
+    struct io_uring_sqe *sqe = get_uring_sqe(state);
+    sqe->opcode = state->read_op;
+    sqe->fd = get_channel_read_h(executor, from);
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = from;
+    // multishot read takes buffer size from provided buffer
+    sqe->len = state->read_op == IORING_OP_READ ? URING_BUF_SIZE : 0;
+    sqe->off = (uint64_t)-1;
+    sqe->user_data = from;
+    state->in[from].is_armed = 1;
+}
+
+/**
+ * @brief      Queue reads of pipes which are open, not armed and have free provided buffers.
+ */
+void arm_uring_reads(executor *executor) {
+    UringState *state = executor->transport_state;
+    for (local_id from = 0; from < executor->proc_n; ++from) {
+        UringInbound *in = &state->in[from];
+        if (from == executor->local_id || in->is_armed || in->is_closed) continue;
+        if (in->held_n == URING_BUF_N) continue;
+        arm_uring_read(executor, from);
+    }
+}
+
+/**
+ * @brief      Queue write of pipe self -> dst outbound buffer. New write takes the active buffer
+ * (messages go to the other one since now), not completed write is continued from the written
+ * position.
+ */
+void submit_uring_write(executor *executor, local_id dst) {
+    UringState    *state = executor->transport_state;
+    UringOutbound *out = &state->out[dst];
+    if (!out->in_flight) {
+        out->active = !out->active;
+        out->in_flight = 1;
+        out->written = 0;
+    }
+    uint8_t              index = !out->active;
+    struct io_uring_sqe *sqe = get_uring_sqe(state);
+    sqe->opcode = IORING_OP_WRITE;
+    sqe->fd = get_channel_write_h(executor, dst);
+    sqe->addr = (uintptr_t)(out->data[index] + out->written);
+    sqe->len = out->size[index] - out->written;
+    sqe->off = (uint64_t)-1;
+    sqe->user_data = dst | URING_WRITE_TAG;
+}
+
+/**
+ * @brief      Queue writes of all outbound buffers which have messages and are not written now.
+ */
+void submit_uring_writes(executor *executor) {
+    UringState *state = executor->transport_state;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        UringOutbound *out = &state->out[dst];
+        if (dst == executor->local_id || out->in_flight || out->is_broken) continue;
+        if (out->size[out->active] > 0) submit_uring_write(executor, dst);
+    }
+}
+
+/**
+ * @brief      Move bytes of held buffers into the channel buffer while there is space and return
+ * copied buffers to the kernel.
+ */
+void move_uring_held(UringInbound *in) {
+    ChannelBuffer *buffer = &in->buffer;
+    if (in->held_n == 0) return;
+    if (buffer->start > 0) {
+        memmove(buffer->data, buffer->data + buffer->start, buffer->end - buffer->start);
+        buffer->end -= buffer->start;
+        buffer->start = 0;
+    }
+    while (in->held_n > 0 && buffer->end < CHANNEL_BUFFER_SIZE) {
+        UringHeldBuf *held = &in->held[in->held_head];
+        size_t        size = min_v(held->size - held->offset, CHANNEL_BUFFER_SIZE - buffer->end);
+        const char   *data = in->buf_data + (size_t)held->bid * URING_BUF_SIZE + held->offset;
+        memcpy(buffer->data + buffer->end, data, size);
+        buffer->end += size;
+        held->offset += size;
+        if (held->offset < held->size) break;
+        provide_uring_buf(in, held->bid);
+        in->held_head = (in->held_head + 1) & (URING_BUF_N - 1);
+        in->held_n--;
+    }
+}
+
+/**
+ * @brief      Handle completion of read from pipe from -> self.
+ */
+void complete_uring_read(executor *executor, local_id from, const struct io_uring_cqe *cqe) {
+    UringState   *state = executor->transport_state;
+    UringInbound *in = &state->in[from];
+    if (!(cqe->flags & IORING_CQE_F_MORE)) in->is_armed = 0;
+    if (cqe->res > 0) {
+        UringHeldBuf *held = &in->held[(in->held_head + in->held_n) & (URING_BUF_N - 1)];
+        held->bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+        held->offset = 0;
+        held->size = cqe->res;
+        in->held_n++;
+        move_uring_held(in);
+        debug_ipc_print(debug_channel_fill_fmt, executor->local_id, from, cqe->res, in->buffer.end);
+        return;
+    }
+    // all buffers are held: read is armed again when they are moved into the channel buffer
+    if (cqe->res == -ENOBUFS) return;
+    // write side is closed and there is nothing to read anymore
+    in->is_closed = 1;
+    if (executor->poll_state[from] == POLL_ACTIVE) executor->poll_n--;
+    executor->poll_state[from] = POLL_CLOSED;
+}
+
+/**
+ * @brief      Handle completion of write to pipe self -> dst.
+ */
+void complete_uring_write(executor *executor, local_id dst, int res) {
+    UringState    *state = executor->transport_state;
+    UringOutbound *out = &state->out[dst];
+    uint8_t        index = !out->active;
+    if (res < 0) {
+        // reader is closed, nothing can be delivered anymore
+        out->is_broken = 1;
+        out->in_flight = 0;
+        out->size[0] = out->size[1] = 0;
+        return;
+    }
+    debug_ipc_print(debug_channel_flush_fmt, executor->local_id, dst, res, out->size[index]);
+    out->written += res;
+    if (out->written < out->size[index]) {
+        submit_uring_write(executor, dst);
+        return;
+    }
+    out->size[index] = 0;
+    out->in_flight = 0;
+}
+
+/**
+ * @brief      Handle all available completions.
+ */
+void reap_uring(executor *executor) {
+    UringState *state = executor->transport_state;
+    unsigned    head = *state->cq_head;
+    unsigned    tail = __atomic_load_n(state->cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        const struct io_uring_cqe *cqe = &state->cqes[head & *state->cq_mask];
+        if (cqe->user_data & URING_WRITE_TAG) {
+            complete_uring_write(executor, cqe->user_data & ~URING_WRITE_TAG, cqe->res);
+        } else {
+            complete_uring_read(executor, cqe->user_data, cqe);
+        }
+        state->cqe_n++;
+    }
+    // release entries only after they are handled
+    __atomic_store_n(state->cq_head, head, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief      Wait until write of pipe self -> dst is completed.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int wait_uring_write(executor *executor, local_id dst) {
+    UringState *state = executor->transport_state;
+    while (state->out[dst].in_flight) {
+        arm_uring_reads(executor);
+        if (enter_uring(state, 1) != 0) return 1;
+        reap_uring(executor);
+    }
+    return 0;
+}
+
+/**
+ * @brief      Create executor ring, register provided buffers and arm reads.
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int init_uring(executor *executor) {
+    UringState            *state = executor->transport_state;
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    state->ring_h = uring_setup(URING_QUEUE_SIZE, &params);
+    if (state->ring_h < 0) return 1;
+    if (map_uring(state, &params) != 0) return 1;
+    if (init_uring_buffers(executor) != 0) return 1;
+    state->read_op = get_uring_read_op(state->ring_h);
+    debug_print(
+        debug_uring_open_fmt, executor->local_id, state->ring_h,
+        state->read_op == IORING_OP_READ ? "read" : "read_multishot"
+    );
+    for (local_id other_id = 0; other_id < executor->proc_n; ++other_id) {
+        if (other_id == executor->local_id) continue;
+        if (set_uring_blocking(get_channel_read_h(executor, other_id)) != 0) return 1;
+        if (set_uring_blocking(get_channel_write_h(executor, other_id)) != 0) return 1;
+    }
+    arm_uring_reads(executor);
+    return enter_uring(state, 0);
+}
+
+void set_executor_uring_channels(int16_t proc_n, void *self, channel **channels) {
+    executor   *executor = self;
+    UringState *state = calloc(1, sizeof(UringState));
+    state->ring_h = -1;
+    state->in = calloc(proc_n, sizeof(UringInbound));
+    state->out = calloc(proc_n, sizeof(UringOutbound));
+    executor->transport_state = state;
+    set_executor_handlers(proc_n, executor, channels);
+    executor->poll_h = -1;
+    executor->poll_n = 0;
+    for (local_id from = 0; from < proc_n; ++from) {
+        executor->poll_state[from] = from == executor->local_id ? POLL_CLOSED : POLL_ACTIVE;
+        executor->poll_n += from != executor->local_id;
+    }
+    if (init_uring(executor) != 0) {
+        // rings and buffers are used by every call, so executor can not run without them
+        perror("Failed to init io_uring");
+        exit(1);
+    }
+}
+
+int flush_uring_channels(void *self) {
+    executor   *executor = self;
+    UringState *state = executor->transport_state;
+    int         rc = 0;
+    reap_uring(executor);
+    submit_uring_writes(executor);
+    arm_uring_reads(executor);
+    if (state->sq_queued > 0 && enter_uring(state, 0) != 0) return 1;
+    for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+        // messages appended while previous write of the pipe is not completed
+        rc |= state->out[dst].in_flight && state->out[dst].size[state->out[dst].active] > 0;
+    }
+    return rc;
+}
+
+int write_uring_channel(void *self, local_id dst, const Message *msg) {
+    executor      *executor = self;
+    UringState    *state = executor->transport_state;
+    UringOutbound *out = &state->out[dst];
+    size_t         msg_size = sizeof(MessageHeader) + msg->s_header.s_payload_len;
+    if (out->size[out->active] + msg_size > OUTBOUND_BUFFER_SIZE) {
+        // both buffers are full, so wait for the written one and write this one
+        if (wait_uring_write(executor, dst) != 0) return 1;
+        if (!out->is_broken) submit_uring_write(executor, dst);
+    }
+    // reader is closed, message is dropped like pipes backend does
+    if (out->is_broken) return 0;
+    memcpy(out->data[out->active] + out->size[out->active], msg, msg_size);
+    out->size[out->active] += msg_size;
+    if (out->size[out->active] >= OUTBOUND_FLUSH_SIZE && !out->in_flight) {
+        submit_uring_write(executor, dst);
+    }
+    return 0;
+}
+
+/**
+ * @brief      Gets the size of the first complete frame of pipe from -> self (0 if there is no
+ * complete frame).
+ */
+uint32_t get_uring_frame_size(UringState *state, local_id from) {
+    UringInbound *in = &state->in[from];
+    uint32_t      frame_size = get_buffered_frame_size(&in->buffer);
+    if (frame_size > 0) return frame_size;
+    move_uring_held(in);
+    return get_buffered_frame_size(&in->buffer);
+}
+
+int read_uring_channel(void *self, local_id from, Message *msg) {
+    executor      *executor = self;
+    UringState    *state = executor->transport_state;
+    ChannelBuffer *buffer = &state->in[from].buffer;
+    uint32_t       frame_size = get_uring_frame_size(state, from);
+    if (frame_size == 0) {
+        reap_uring(executor);
+        frame_size = get_uring_frame_size(state, from);
+    }
+    if (frame_size == 0) return -1;
+    memcpy(msg, buffer->data + buffer->start, frame_size);
+    buffer->start += frame_size;
+    if (buffer->start == buffer->end) buffer->start = buffer->end = 0;
+    return 0;
+}
+
+int wait_uring_ready(void *self, local_id *ready, int timeout) {
+    executor   *executor = self;
+    UringState *state = executor->transport_state;
+    int         is_waited = 0;
+    while (1) {
+        int ready_n = 0;
+        reap_uring(executor);
+        for (local_id from = 0; from < executor->proc_n; ++from) {
+            if (from == executor->local_id || executor->poll_state[from] == POLL_MASKED) continue;
+            if (get_uring_frame_size(state, from) > 0) ready[ready_n++] = from;
+        }
+        if (ready_n > 0) return ready_n;
+        if (executor->poll_n == 0) return -1;
+        if (timeout == POLL_NOWAIT || (timeout > 0 && is_waited)) return 0;
+        // writes and re-armed reads are submitted with the same call that waits
+        submit_uring_writes(executor);
+        arm_uring_reads(executor);
+        // completions are reaped once more after timeout, then executor gives up
+        if (enter_uring_timeout(state, 1, timeout) > 0) return -1;
+        is_waited = 1;
+    }
+}
+
+int wait_uring_one_ready(void *self, local_id from, int timeout) {
+    executor   *executor = self;
+    UringState *state = executor->transport_state;
+    int         is_waited = 0;
+    while (1) {
+        reap_uring(executor);
+        if (get_uring_frame_size(state, from) > 0) return 1;
+        if (state->in[from].is_closed) return -1;
+        if (timeout == POLL_NOWAIT || (timeout > 0 && is_waited)) return 0;
+        submit_uring_writes(executor);
+        arm_uring_reads(executor);
+        if (enter_uring_timeout(state, 1, timeout) > 0) return -1;
+        is_waited = 1;
+    }
+}
+
+void cleanup_uring_executor(void *self) {
+    executor   *executor = self;
+    UringState *state = executor->transport_state;
+    if (state->ring_h >= 0) {
+        // messages must be delivered before exit (unless the reader is closed)
+        for (local_id dst = 0; dst < executor->proc_n; ++dst) {
+            UringOutbound *out = &state->out[dst];
+            if (dst == executor->local_id) continue;
+            while (!out->is_broken && (out->in_flight || out->size[out->active] > 0)) {
+                if (!out->in_flight) submit_uring_write(executor, dst);
+                if (wait_uring_write(executor, dst) != 0) break;
+            }
+        }
+        debug_ipc_print(
+            debug_uring_stats_fmt, executor->local_id, state->enter_n, state->sqe_n, state->cqe_n
+        );
+    }
+    close_channel_handler(&state->ring_h);
+    if (state->sq_mask != NULL) {
+        munmap(state->sqes, (*state->sq_mask + 1) * sizeof(struct io_uring_sqe));
+    }
+    int is_cq_mapped = state->cq_ring != NULL && state->cq_ring != MAP_FAILED;
+    if (is_cq_mapped && state->cq_ring != state->sq_ring) {
+        munmap(state->cq_ring, state->cq_ring_size);
+    }
+    if (state->sq_ring != NULL && state->sq_ring != MAP_FAILED) {
+        munmap(state->sq_ring, state->sq_ring_size);
+    }
+    if (state->buf_rings != NULL) munmap(state->buf_rings, state->buf_rings_size);
+    free(state->buf_data);
+    free(state->in);
+    free(state->out);
+    free(state);
+    free(executor->ch_read);
+    free(executor->ch_write);
+}
+
+const transport uring_transport = {
+    .name = "uring",
+    .open = open_uring_channels,
+    .set_executor = set_executor_uring_channels,
+    .close_unused = close_unused_channels,
+    .close = close_channels,
+    .cleanup = cleanup_uring_executor,
+    .flush = flush_uring_channels,
+    .write = write_uring_channel,
+    .read = read_uring_channel,
+    .wait_ready = wait_uring_ready,
+    .wait_one_ready = wait_uring_one_ready,
+    .mask = mask_poll_state,
+    .unmask = unmask_poll_state,
+};
@@ -0,0 +1,143 @@
+/**
+ * @file     uring.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    io_uring transport: pipes matrix with reads and writes submitted through io_uring
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_URING__H
+#define __ITMO_DISTRIBUTED_CLASS_URING__H
+
+#include <linux/io_uring.h>
+#include <stdint.h>
+
+#include "channels.h"
+#include "ipc.h"
+
+#define URING_QUEUE_SIZE 64     // submission queue entries (>= reads and writes of one iteration)
+#define URING_BUF_N      16     // provided buffers for one reading pipe (power of two)
+#define URING_BUF_SIZE   4096   // bytes in one provided buffer
+
+/**
+ * Provided buffer filled by a completed read, but not copied into the channel buffer yet
+ */
+typedef struct {
+    uint16_t bid;     ///< Provided buffer id
+    uint16_t offset;  ///< Position of the first not copied byte
+    uint16_t size;    ///< Number of read bytes
+} UringHeldBuf;
+
+/**
+ * Pipe from -> self. Read stays armed while the pipe is open and has free provided buffers (own
+ * buffers group per pipe, so a pipe which is not read does not stop reading of others). Completed
+ * reads are held and moved into the channel buffer when there is space for them.
+ */
+typedef struct {
+    ChannelBuffer             buffer;             ///< Bytes to decode messages from
+    struct io_uring_buf_ring *buf_ring;           ///< Provided buffers ring (group id is from)
+    char                     *buf_data;           ///< Provided buffers memory
+    uint16_t                  buf_tail;           ///< Provided buffers ring tail
+    UringHeldBuf              held[URING_BUF_N];  ///< Completed reads (FIFO)
+    uint16_t                  held_head;          ///< Position of the first held buffer
+    uint16_t                  held_n;             ///< Number of held buffers
+    uint8_t                   is_armed;           ///< Read is submitted and produces completions
+    uint8_t                   is_closed;          ///< Write side is closed (end of file is read)
+} UringInbound;
+
+/**
+ * Pipe self -> dst. Messages are appended to the active buffer while the other one is written, so
+ * bytes of a submitted write are never changed until its completion.
+ */
+typedef struct {
+    char     data[2][OUTBOUND_BUFFER_SIZE];  ///< Message frames buffers
+    uint32_t size[2];                        ///< Number of bytes in buffers
+    uint32_t written;                        ///< Bytes of the written buffer already completed
+    uint8_t  active;                         ///< Buffer index messages are appended to
+    uint8_t  in_flight;                      ///< Write of buffer !active is submitted
+    uint8_t  is_broken;                      ///< Reader is closed, messages are dropped
+} UringOutbound;
+
+/**
+ * io_uring backend executor state
+ */
+typedef struct {
+    int                  ring_h;          ///< io_uring handler
+    uint8_t              read_op;         ///< Read operation (multishot if supported)
+    void                *sq_ring;         ///< Submission queue ring mapping
+    size_t               sq_ring_size;    ///< Submission queue ring mapping size
+    unsigned            *sq_head;         ///< Submission queue head (kernel)
+    unsigned            *sq_tail;         ///< Submission queue tail (shared)
+    unsigned            *sq_mask;         ///< Submission queue index mask
+    unsigned            *sq_array;        ///< Submission queue entries indexes
+    unsigned             sq_queued;       ///< Entries queued, but not submitted yet
+    struct io_uring_sqe *sqes;            ///< Submission queue entries
+    void                *cq_ring;         ///< Completion queue ring mapping
+    size_t               cq_ring_size;    ///< Completion queue ring mapping size
+    unsigned            *cq_head;         ///< Completion queue head (shared)
+    unsigned            *cq_tail;         ///< Completion queue tail (kernel)
+    unsigned            *cq_mask;         ///< Completion queue index mask
+    struct io_uring_cqe *cqes;            ///< Completion queue entries
+    void                *buf_rings;       ///< Provided buffers rings mapping (page per pipe)
+    size_t               buf_rings_size;  ///< Provided buffers rings mapping size
+    char                *buf_data;        ///< Provided buffers memory of all pipes
+    UringInbound        *in;              ///< Reading pipes (indexed by source local id)
+    UringOutbound       *out;             ///< Writing pipes (indexed by destination local id)
+    uint32_t             enter_n;         ///< Number of io_uring_enter calls
+    uint32_t             sqe_n;           ///< Number of submitted entries
+    uint32_t             cqe_n;           ///< Number of reaped completions
+} UringState;
+
+/**
+ * @brief      Opens pipes matrix and checks that io_uring with provided buffer rings is available.
+ * Must be called before fork.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      channels  The channels matrix
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int open_uring_channels(int16_t proc_n, channel **channels);
+
+/**
+ * @brief      Sets the executor pipes and creates executor io_uring with provided buffers. Reads
+ * are armed on every reading pipe. Executor process exits if io_uring can not be initialized.
+ *
+ * @param[in]  proc_n    The number of processes
+ * @param      executor  The executor
+ * @param      channels  The channels matrix
+ */
+void set_executor_uring_channels(int16_t proc_n, void *executor, channel **channels);
+
+/**
+ * @brief      Queues write requests for all buffered messages and submits them together with
+ * re-armed reads with one io_uring_enter call.
+ *
+ * @param      executor  The executor
+ *
+ * @return     0 on success, any non-zero value if some messages are still not submitted
+ */
+int flush_uring_channels(void *executor);
+
+/**
+ * @brief      Appends a message to the pipe self -> dst outbound buffer. Buffer is submitted on
+ * flush (or when it is full).
+ *
+ * @param      executor  The executor
+ * @param[in]  dst       The destination process local id
+ * @param[in]  msg       The message
+ *
+ * @return     0 on success, any non-zero value on error
+ */
+int write_uring_channel(void *executor, local_id dst, const Message *msg);
+
+/**
+ * @brief      Decodes a message from bytes read from the pipe from -> self.
+ *
+ * @param      executor  The executor
+ * @param[in]  from      The from process local id
+ * @param      msg       The message
+ *
+ * @return     0 on success, any non-zero value if there is no complete message
+ */
+int read_uring_channel(void *executor, local_id from, Message *msg);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_URING__H
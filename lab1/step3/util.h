@@ -10,5 +10,6 @@
 // WARN: possible side effects here
 // https://gcc.gnu.org/onlinedocs/cpp/Duplication-of-Side-Effects.html
 #define max_v(_a, _b) (_a > _b ? _a : _b)
+#define min_v(_a, _b) (_a < _b ? _a : _b)
 
 #endif  // __IFMO_DISTRIBUTED_CLASS_UTIL__H
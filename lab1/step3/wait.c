@@ -0,0 +1,132 @@
+// usleep and clock_gettime are not a part of c99
+#define _DEFAULT_SOURCE
+
+#include "wait.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "channels.h"
+#include "debug.h"
+#include "executor.h"
+
+static const wait_policy *const wait_policies[] = {
+    &block_wait_policy,      &spin_wait_policy,  &backoff_wait_policy,
+    &spin_block_wait_policy, &sleep_wait_policy,
+};
+
+const wait_policy *find_wait_policy(const char *name) {
+    for (size_t i = 0; i < sizeof(wait_policies) / sizeof(wait_policies[0]); ++i) {
+        if (strcmp(wait_policies[i]->name, name) == 0) return wait_policies[i];
+    }
+    return NULL;
+}
+
+const wait_policy *get_default_wait_policy() {
+    return &block_wait_policy;
+}
+
+uint64_t get_wait_time_ns() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+/**
+ * @brief      Tell CPU that this is a spin loop (lets sibling hyper thread run).
+ */
+void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+/**
+ * @brief      Call probe without blocking n times (or until it returns non-zero value).
+ */
+int spin_probe(void *self, WaitStats *stats, wait_probe_t probe, void *arg, uint32_t n) {
+    uint64_t start = get_wait_time_ns();
+    int      rc = 0;
+    for (uint32_t i = 0; i < n && (rc = probe(self, arg, POLL_NOWAIT)) == 0; ++i) cpu_relax();
+    stats->spin_ns += get_wait_time_ns() - start;
+    return rc;
+}
+
+/**
+ * @brief      Call blocking probe.
+ */
+int block_probe(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    uint64_t start = get_wait_time_ns();
+    int      rc = probe(self, arg, POLL_BLOCK);
+    stats->sleep_ns += get_wait_time_ns() - start;
+    stats->sleep_n++;
+    return rc;
+}
+
+/**
+ * @brief      Sleep for usec.
+ */
+void sleep_wait(WaitStats *stats, unsigned long usec) {
+    uint64_t start = get_wait_time_ns();
+    usleep(usec);
+    stats->sleep_ns += get_wait_time_ns() - start;
+    stats->sleep_n++;
+}
+
+int wait_block(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    return block_probe(self, stats, probe, arg);
+}
+
+int wait_spin(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    int rc = 0;
+    while ((rc = spin_probe(self, stats, probe, arg, UINT32_MAX)) == 0) {}
+    return rc;
+}
+
+int wait_backoff(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    unsigned long delay = WAIT_BACKOFF_MIN_USEC;
+    int           rc = 0;
+    while ((rc = spin_probe(self, stats, probe, arg, 1)) == 0) {
+        sleep_wait(stats, delay);
+        if (delay < WAIT_BACKOFF_MAX_USEC) delay *= 2;
+    }
+    return rc;
+}
+
+int wait_spin_block(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    int rc = spin_probe(self, stats, probe, arg, WAIT_SPIN_N);
+    if (rc != 0) return rc;
+    return block_probe(self, stats, probe, arg);
+}
+
+int wait_sleep(void *self, WaitStats *stats, wait_probe_t probe, void *arg) {
+    int rc = 0;
+    while ((rc = spin_probe(self, stats, probe, arg, 1)) == 0) sleep_wait(stats, WAIT_SLEEP_USEC);
+    return rc;
+}
+
+int wait_by_policy(void *self, wait_probe_t probe, void *arg) {
+    executor *executor = self;
+    executor->wait_stats.wait_n++;
+    return executor->wait_policy->wait(executor, &executor->wait_stats, probe, arg);
+}
+
+void print_wait_stats(void *self) {
+    executor  *executor = self;
+    WaitStats *stats = &executor->wait_stats;
+    debug_worker_print(
+        debug_wait_stats_fmt, executor->local_id, executor->wait_policy->name, stats->wait_n,
+        stats->spin_ns / 1000000.0, stats->sleep_ns / 1000000.0, stats->sleep_n
+    );
+}
+
+const wait_policy block_wait_policy = {.name = "block", .wait = wait_block};
+const wait_policy spin_wait_policy = {.name = "spin", .wait = wait_spin};
+const wait_policy backoff_wait_policy = {.name = "backoff", .wait = wait_backoff};
+const wait_policy spin_block_wait_policy = {.name = "spin-block", .wait = wait_spin_block};
+const wait_policy sleep_wait_policy = {.name = "sleep", .wait = wait_sleep};
@@ -0,0 +1,89 @@
+/**
+ * @file     wait.h
+ * @Author   Gurin Evgeny and Kamyshanskaya Kseniia
+ * @brief    Wait policies: how executor waits for messages when there is nothing to receive
+ */
+
+#ifndef __ITMO_DISTRIBUTED_CLASS_WAIT__H
+#define __ITMO_DISTRIBUTED_CLASS_WAIT__H
+
+#include <stdint.h>
+
+#define WAIT_SLEEP_USEC       50    // usec between checks of fixed sleep policy
+#define WAIT_BACKOFF_MIN_USEC 1     // first sleep of exponential backoff policy
+#define WAIT_BACKOFF_MAX_USEC 1024  // max sleep of exponential backoff policy
+#define WAIT_SPIN_N           4096  // checks of spin then block policy before blocking
+
+/**
+ * Time spent by executor waiting for messages
+ */
+typedef struct {
+    uint64_t spin_ns;   ///< Time of checks without blocking (busy waiting)
+    uint64_t sleep_ns;  ///< Time of sleeping and blocking in transport
+    uint32_t wait_n;    ///< Number of waits
+    uint32_t sleep_n;   ///< Number of sleeps and blocking waits
+} WaitStats;
+
+/**
+ * @brief      Checks channels with timeout (POLL_BLOCK or POLL_NOWAIT).
+ *
+ * @return     Positive value if channels are ready, 0 if not, negative value on error
+ */
+typedef int (*wait_probe_t)(void *executor, void *arg, int timeout);
+
+/**
+ * Wait policy. Wait calls probe until it returns non-zero value and returns that value
+ */
+typedef struct {
+    const char *name;  ///< Policy name used in command line
+    int (*wait)(void *executor, WaitStats *stats, wait_probe_t probe, void *arg);
+} wait_policy;
+
+extern const wait_policy block_wait_policy;       ///< Block in transport (epoll, futex, etc.)
+extern const wait_policy spin_wait_policy;        ///< Busy spin with pause instruction
+extern const wait_policy backoff_wait_policy;     ///< Sleep with exponentially growing delay
+extern const wait_policy spin_block_wait_policy;  ///< Spin WAIT_SPIN_N checks, then block
+extern const wait_policy sleep_wait_policy;       ///< Sleep WAIT_SLEEP_USEC between checks
+
+/**
+ * @brief      Gets monotonic time in nanoseconds (for wait statistics).
+ *
+ * @return     The time in nanoseconds.
+ */
+uint64_t get_wait_time_ns();
+
+/**
+ * @brief      Finds a wait policy by name.
+ *
+ * @param[in]  name  The policy name
+ *
+ * @return     The wait policy, NULL if there is no policy with this name
+ */
+const wait_policy *find_wait_policy(const char *name);
+
+/**
+ * @brief      Gets the default wait policy.
+ *
+ * @return     The default wait policy.
+ */
+const wait_policy *get_default_wait_policy();
+
+/**
+ * @brief      Waits with executor policy until probe returns non-zero value.
+ *
+ * @param      executor  The executor
+ * @param[in]  probe     The channels check
+ * @param      arg       The probe argument
+ *
+ * @return     The probe result
+ */
+int wait_by_policy(void *executor, wait_probe_t probe, void *arg);
+
+/**
+ * @brief      Prints executor wait statistics (debug worker messages).
+ *
+ * @param      executor  The executor
+ */
+void print_wait_stats(void *executor);
+
+#endif  // __ITMO_DISTRIBUTED_CLASS_WAIT__H
@@ -6,6 +6,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "bitset.h"
 #include "channels.h"
 #include "communicator.h"
 #include "debug.h"
@@ -15,6 +16,9 @@
 #include "logger.h"
 #include "pa2345.h"
 #include "time.h"
+#include "transport.h"
+#include "tree.h"
+#include "wait.h"
 
 /**
  * @brief      Determines whether the specified self and other children is all done.
@@ -24,10 +28,8 @@
  * @return     True if the specified self is all done, False otherwise.
  */
 int is_all_done(executor *self) {
-    for (int i = 1; i < self->proc_n; ++i) {
-        if (!self->proc_done[i]) return 0;
-    }
-    return 1;
+    int done_n = count_bits(self->proc_done, self->proc_n) - is_bit_set(self->proc_done, PARENT_ID);
+    return done_n == self->proc_n - 1;
 }
 
 /**
@@ -38,22 +40,22 @@ int is_all_done(executor *self) {
  * @return     True if the specified self is self done, False otherwise.
  */
 int is_self_done(executor *self) {
-    return self->proc_done[self->local_id];
+    return is_bit_set(self->proc_done, self->local_id);
 }
 
 void set_done(executor *self, local_id from) {
-    self->proc_done[from] = 1;
+    set_bit(self->proc_done, from);
     if (is_all_done(self)) {
         log_events_msg(log_received_all_done_fmt, get_lamport_time(), self->local_id);
         self->all_done = 1;
     }
 }
 
-void on_done(executor *self, Message *msg, local_id from) {
+void on_done(executor *self, const Message *msg, local_id from) {
     set_done(self, from);
 }
 
-void on_message(executor *self, Message *msg, local_id from) {
+void on_message(executor *self, const Message *msg, local_id from) {
     switch (msg->s_header.s_type) {
         case CS_RELEASE:
             on_release_cs(self, msg, from);
@@ -109,7 +111,7 @@ void child_worker(executor *self) {
     while (!self->is_self_done) do_main_work(self, &main_loop_idx);
     child_done(self);
     while (!self->all_done) {
-        if (receive_any_cb(self, on_message) != 0) usleep(SLEEP_RECEIVE_USEC);
+        if (wait_receive_any_cb(self, on_message) != 0) break;
     }
     hanle_pending(self, on_message);
 }
@@ -132,13 +134,23 @@ void run_worker(executor *self) {
     debug_worker_print(debug_worker_run_fmt, self->pid, self->parent_pid, self->local_id);
     if (self->local_id == PARENT_ID) parent_worker(self);
     else child_worker(self);
+    flush_all(self);
 }
 
 void init_executor(
-    executor *executor, channel **channels, local_id local_id, int proc_n, pid_t pid, pid_t p_pid,
+    executor *executor, channel **channels, const transport *transport,
+    const wait_policy *wait_policy, local_id local_id, int proc_n, pid_t pid, pid_t p_pid,
     uint8_t use_lock
 ) {
     executor->local_id = local_id;
+    executor->transport = transport;
+    executor->transport_state = NULL;
+    executor->borrowed = malloc(sizeof(Message));
+    init_msg_pool(&executor->msg_pool);
+    init_lanes(&executor->lanes, proc_n);
+    init_tree(&executor->tree, proc_n);
+    executor->wait_policy = wait_policy;
+    memset(&executor->wait_stats, 0, sizeof(executor->wait_stats));
     executor->proc_n = proc_n;
     executor->pid = pid;
     executor->parent_pid = p_pid;
@@ -148,17 +160,34 @@ void init_executor(
 
     init_lock(executor);
 
-    for (int i = 0; i <= MAX_PROCESS_ID; ++i) {
-        executor->proc_done[i] = 0;
-        executor->last_recv_at[i] = 0;
-        executor->last_send_at[i] = 0;
-    }
+    executor->poll_state = malloc(proc_n * sizeof(uint8_t));
+    executor->proc_done = new_bitset(proc_n);
+    executor->last_recv_at = calloc(proc_n, sizeof(timestamp_t));
+    executor->last_send_at = calloc(proc_n, sizeof(timestamp_t));
 
-    set_executor_channels(proc_n, executor, channels);
-    close_unused_channels(proc_n, local_id, channels);
+    transport->set_executor(proc_n, executor, channels);
+    transport->close_unused(proc_n, local_id, channels);
 }
 
 void cleanup_executor(executor *executor) {
-    free(executor->ch_read);
-    free(executor->ch_write);
+    print_wait_stats(executor);
+    executor->transport->cleanup(executor);
+    free(executor->borrowed);
+    destroy_lanes(&executor->lanes);
+    if (is_tree_enabled()) {
+        debug_worker_print(
+            debug_tree_stats_fmt, executor->local_id, get_tree_fanout(), executor->tree.forwarded_n
+        );
+    }
+    destroy_tree(&executor->tree);
+    destroy_lock(executor);
+    free(executor->poll_state);
+    free(executor->proc_done);
+    free(executor->last_recv_at);
+    free(executor->last_send_at);
+    debug_worker_print(
+        debug_msg_pool_stats_fmt, executor->local_id, executor->msg_pool.alloc_n,
+        executor->msg_pool.malloc_n, executor->lanes.deferred_n
+    );
+    destroy_msg_pool(&executor->msg_pool);
 }
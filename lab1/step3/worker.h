@@ -13,6 +13,8 @@
 #include "channels.h"
 #include "executor.h"
 #include "ipc.h"
+#include "transport.h"
+#include "wait.h"
 
 /**
  * @brief      Child worker main logic
@@ -40,6 +42,8 @@ void run_worker(executor *self);
  *
  * @param      executor       The executor
  * @param      channels       The channels matrix
+ * @param[in]  transport      The transport backend
+ * @param[in]  wait_policy    The wait policy
  * @param[in]  local_id       The local identifier
  * @param[in]  proc_n         The number of processes
  * @param[in]  pid            The pid of executor
@@ -47,7 +51,8 @@ void run_worker(executor *self);
  * @param[in]  use_lock       Indicates if lock is used
  */
 void init_executor(
-    executor *executor, channel **channels, local_id local_id, int proc_n, pid_t pid, pid_t p_pid,
+    executor *executor, channel **channels, const transport *transport,
+    const wait_policy *wait_policy, local_id local_id, int proc_n, pid_t pid, pid_t p_pid,
     uint8_t use_lock
 );
 